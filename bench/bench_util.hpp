@@ -0,0 +1,186 @@
+#ifndef BENCH_UTIL_H
+
+#define BENCH_UTIL_H
+
+#include "../src/perf_counters.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+struct AllocStats {
+    size_t allocations = 0;
+    size_t reallocations = 0;
+    size_t bytes = 0;
+    size_t live = 0;
+};
+
+inline AllocStats alloc_stats;
+inline PerfCounters* perf_counters = nullptr;
+
+template <class T>
+class CountingAllocator {
+public:
+    using value_type = T;
+    constexpr CountingAllocator() noexcept = default;
+    template <class U>
+    constexpr CountingAllocator(const CountingAllocator<U>&) noexcept {}
+    T* allocate(size_t cnt) {
+        T* ptr = std::allocator<T>().allocate(cnt);
+        ++alloc_stats.allocations;
+        if (alloc_stats.live != 0)
+            ++alloc_stats.reallocations;
+        ++alloc_stats.live;
+        alloc_stats.bytes += cnt * sizeof(T);
+        return ptr;
+    }
+    void deallocate(T* ptr, size_t cnt) noexcept {
+        --alloc_stats.live;
+        std::allocator<T>().deallocate(ptr, cnt);
+    }
+    template <class U>
+    constexpr bool operator==(const CountingAllocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+struct Sample {
+    double ns_per_op = 0;
+    double allocations = 0;
+    double reallocations = 0;
+    double bytes = 0;
+    PerfCounters::Sample perf;
+    size_t ops = 0;
+};
+
+class Stopwatch {
+public:
+    void start() noexcept {
+        before = alloc_stats;
+        if (perf_counters != nullptr)
+            perf_counters->start();
+        started = std::chrono::steady_clock::now();
+    }
+    void stop() noexcept {
+        elapsed += std::chrono::steady_clock::now() - started;
+        if (perf_counters != nullptr)
+            perf_counters->stop();
+        allocations += alloc_stats.allocations - before.allocations;
+        reallocations += alloc_stats.reallocations - before.reallocations;
+        bytes += alloc_stats.bytes - before.bytes;
+    }
+    Sample sample(size_t reps, size_t ops_per_rep) const noexcept {
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        Sample res;
+        res.ns_per_op = ns / (reps * ops_per_rep);
+        res.allocations = static_cast<double>(allocations) / reps;
+        res.reallocations = static_cast<double>(reallocations) / reps;
+        res.bytes = static_cast<double>(bytes) / reps;
+        if (perf_counters != nullptr)
+            res.perf = perf_counters->sample();
+        res.ops = reps * ops_per_rep;
+        return res;
+    }
+private:
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::duration elapsed{};
+    AllocStats before;
+    size_t allocations = 0;
+    size_t reallocations = 0;
+    size_t bytes = 0;
+};
+
+template <class Body>
+Sample measure(size_t reps, size_t ops_per_rep, Body&& body) {
+    if (perf_counters != nullptr)
+        perf_counters->reset();
+    Stopwatch watch;
+    for (size_t i = 0; i < reps; ++i)
+        body(watch);
+    return watch.sample(reps, ops_per_rep);
+}
+
+template <class T>
+void keep(const T& val) noexcept {
+    asm volatile("" : : "g"(&val) : "memory");
+}
+
+struct Result {
+    std::string op;
+    std::string type;
+    size_t n;
+    Sample vec;
+    Sample std;
+};
+
+inline void print_header() {
+    printf("%-18s %-10s %10s %12s %12s %10s %10s %12s %12s %14s %14s\n",
+        "op", "type", "n", "Vector ns", "std ns", "V allocs", "std allocs", "V reallocs", "std reallocs",
+        "V bytes", "std bytes");
+}
+
+inline void print_result(const Result& res) {
+    printf("%-18s %-10s %10zu %12.2f %12.2f %10.1f %10.1f %12.1f %12.1f %14.0f %14.0f\n",
+        res.op.c_str(), res.type.c_str(), res.n,
+        res.vec.ns_per_op, res.std.ns_per_op,
+        res.vec.allocations, res.std.allocations,
+        res.vec.reallocations, res.std.reallocations,
+        res.vec.bytes, res.std.bytes);
+    if (perf_counters == nullptr || !perf_counters->available())
+        return;
+    printf("%-18s", "  per op");
+    for (size_t i = 0; i < PerfCounters::EVENT_COUNT; ++i) {
+        auto event = static_cast<PerfCounters::Event>(i);
+        printf(" %s %.2f/%.2f", PerfCounters::name(event),
+            res.vec.perf.per(event, res.vec.ops), res.std.perf.per(event, res.std.ops));
+    }
+    printf(" running %.2f/%.2f\n", res.vec.perf.running, res.std.perf.running);
+}
+
+inline void write_perf_json(FILE* out, const Sample& sample) {
+    fprintf(out, ", \"perf\": {");
+    for (size_t i = 0; i < PerfCounters::EVENT_COUNT; ++i) {
+        auto event = static_cast<PerfCounters::Event>(i);
+        double val = sample.perf.per(event, sample.ops);
+        fprintf(out, i == 0 ? "" : ", ");
+        if (std::isnan(val))
+            fprintf(out, "\"%s\": null", PerfCounters::name(event));
+        else
+            fprintf(out, "\"%s\": %.4f", PerfCounters::name(event), val);
+    }
+    fprintf(out, ", \"running\": %.4f}", sample.perf.running);
+}
+
+inline void write_sample_json(FILE* out, const char* key, const Sample& sample) {
+    fprintf(out, "\"%s\": {\"ns_per_op\": %.3f, \"allocations\": %.2f, \"reallocations\": %.2f, \"bytes\": %.0f",
+        key, sample.ns_per_op, sample.allocations, sample.reallocations, sample.bytes);
+    if (perf_counters != nullptr)
+        write_perf_json(out, sample);
+    fprintf(out, "}");
+}
+
+inline bool write_json(const char* path, const char* suite, const std::vector<Result>& results) {
+    FILE* out = fopen(path, "w");
+    if (out == nullptr)
+        return false;
+    fprintf(out, "{\n  \"suite\": \"%s\",\n  \"results\": [\n", suite);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& res = results[i];
+        fprintf(out, "    {\"op\": \"%s\", \"type\": \"%s\", \"n\": %zu, ",
+            res.op.c_str(), res.type.c_str(), res.n);
+        write_sample_json(out, "vector", res.vec);
+        fprintf(out, ", ");
+        write_sample_json(out, "std", res.std);
+        fprintf(out, "}%s\n", i + 1 == results.size() ? "" : ",");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return true;
+}
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "bench_util.hpp"
+#include "../src/atomic_bits.hpp"
+#include "../src/jagged_vector.hpp"
+#include "../src/thread_pool.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    using Graph = JaggedVector<uint32_t>;
+
+    class AtomicBits {
+    public:
+        explicit AtomicBits(size_t vertices): bits(vertices, false), view(bits) {}
+        bool claim(uint32_t vertex) noexcept {
+            return !view.test(vertex, std::memory_order_relaxed) && !view.test_and_set(vertex, std::memory_order_relaxed);
+        }
+        size_t bytes() const noexcept {
+            return bits.words().size_bytes();
+        }
+        size_t visited(size_t workers) const {
+            ThreadPool pool(workers);
+            return view.count(pool);
+        }
+    private:
+        Vector<bool> bits;
+        AtomicBitView view;
+    };
+
+    class AtomicBytes {
+    public:
+        explicit AtomicBytes(size_t vertices): flags(new std::atomic<uint8_t>[vertices]()), sz(vertices) {}
+        bool claim(uint32_t vertex) noexcept {
+            return flags[vertex].load(std::memory_order_relaxed) == 0
+                && flags[vertex].exchange(1, std::memory_order_relaxed) == 0;
+        }
+        size_t bytes() const noexcept {
+            return sz;
+        }
+        size_t visited(size_t) const noexcept {
+            size_t res = 0;
+            for (size_t i = 0; i < sz; ++i)
+                res += flags[i].load(std::memory_order_relaxed);
+            return res;
+        }
+    private:
+        std::unique_ptr<std::atomic<uint8_t>[]> flags;
+        size_t sz;
+    };
+
+    class LockedBits {
+    public:
+        explicit LockedBits(size_t vertices): bits(vertices, false) {}
+        bool claim(uint32_t vertex) {
+            std::lock_guard guard(lock);
+            if (bits[vertex])
+                return false;
+            bits[vertex] = true;
+            return true;
+        }
+        size_t bytes() const noexcept {
+            return bits.words().size_bytes();
+        }
+        size_t visited(size_t) const noexcept {
+            return bits.count();
+        }
+    private:
+        std::mutex lock;
+        Vector<bool> bits;
+    };
+
+    Graph make_graph(size_t vertices, size_t degree) {
+        std::mt19937_64 gen(vertices);
+        Vector<std::pair<size_t, uint32_t>> edges;
+        edges.reserve(vertices * degree);
+        for (size_t i = 0; i < vertices * degree; ++i)
+            edges.emplace_back(gen() % vertices, static_cast<uint32_t>(gen() % vertices));
+        return Graph::from_pairs(vertices, edges);
+    }
+
+    template <class Visited>
+    size_t bfs(const Graph& graph, Visited& visited, size_t workers) {
+        Vector<uint32_t> frontier{0};
+        Vector<Vector<uint32_t>> next(workers);
+        Vector<size_t> edges(workers);
+        visited.claim(0);
+        std::barrier sync(workers);
+        auto work = [&] (size_t w) {
+            while (true) {
+                size_t first = frontier.size() * w / workers;
+                size_t last = frontier.size() * (w + 1) / workers;
+                for (size_t i = first; i < last; ++i) {
+                    for (uint32_t to : graph[frontier[i]]) {
+                        ++edges[w];
+                        if (visited.claim(to))
+                            next[w].push_back(to);
+                    }
+                }
+                sync.arrive_and_wait();
+                if (w == 0) {
+                    frontier.clear();
+                    for (Vector<uint32_t>& part : next) {
+                        frontier.append_range(part);
+                        part.clear();
+                    }
+                }
+                sync.arrive_and_wait();
+                if (frontier.empty())
+                    return;
+            }
+        };
+        Vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t w = 1; w < workers; ++w)
+            threads.emplace_back(work, w);
+        work(0);
+        for (std::thread& thread : threads)
+            thread.join();
+        size_t res = 0;
+        for (size_t cnt : edges)
+            res += cnt;
+        return res;
+    }
+
+    template <class Visited>
+    void run(const char* visited_set, const Graph& graph, size_t workers) {
+        size_t edge_cnt = 0;
+        size_t reached = 0;
+        size_t bytes = 0;
+        Sample sample = bench::measure(3, 1, [&] (Stopwatch& watch) {
+            Visited visited(graph.size());
+            watch.start();
+            edge_cnt = bfs(graph, visited, workers);
+            watch.stop();
+            reached = visited.visited(workers);
+            bytes = visited.bytes();
+        });
+        printf("%-14s %8zu %12.2f %10.1f %12zu %12zu\n", visited_set, workers, sample.ns_per_op / 1e6,
+            edge_cnt / (sample.ns_per_op / 1e3), reached, bytes);
+    }
+
+    void run_count(size_t vertices, size_t workers) {
+        Vector<bool> bits(vertices, false);
+        for (size_t i = 0; i < vertices; i += 3)
+            bits[i] = true;
+        AtomicBitView view(bits);
+        ThreadPool pool(workers);
+        Sample sample = bench::measure(5, vertices, [&] (Stopwatch& watch) {
+            watch.start();
+            size_t cnt = view.count(pool);
+            watch.stop();
+            bench::keep(cnt);
+        });
+        printf("%-14s %8zu %12.4f\n", "count", workers, sample.ns_per_op);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t vertices = size_t(1) << 22;
+    size_t degree = 8;
+    size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--vertices") == 0 && i + 1 < argc) {
+            vertices = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            max_threads = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--vertices N] [--degree N] [--max-threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (vertices == 0 || vertices > UINT32_MAX) {
+        fprintf(stderr, "--vertices must be in [1, 2^32)\n");
+        return 2;
+    }
+    Graph graph = make_graph(vertices, degree);
+    printf("%-14s %8s %12s %10s %12s %12s\n", "visited set", "threads", "ms", "MTEPS", "reached", "bytes");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run<AtomicBits>("atomic bits", graph, threads);
+        run<AtomicBytes>("atomic bytes", graph, threads);
+        run<LockedBits>("locked bits", graph, threads);
+    }
+    printf("\n%-14s %8s %12s\n", "op", "threads", "ns/bit");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+        run_count(vertices, threads);
+    return 0;
+}
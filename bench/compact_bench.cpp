@@ -0,0 +1,86 @@
+#include "bench_util.hpp"
+#include "../src/vector.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+    using bench::Stopwatch;
+
+    const size_t LIST_SIZES[] = {0, 1, 4};
+
+    double rss_mb() {
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (file == nullptr)
+            return 0;
+        size_t pages = 0;
+        size_t resident = 0;
+        int read = fscanf(file, "%zu %zu", &pages, &resident);
+        fclose(file);
+        return read == 2 ? static_cast<double>(resident * sysconf(_SC_PAGESIZE)) / (1 << 20) : 0;
+    }
+
+    template <class List>
+    void run(const char* container, size_t count, size_t list_size) {
+        bench::alloc_stats = {};
+        double base = rss_mb();
+        double rss = 0;
+        double build_ns = 0;
+        double scan_ns = 0;
+        {
+            Vector<List> lists;
+            build_ns = bench::measure(1, count, [&] (Stopwatch& watch) {
+                watch.start();
+                lists.resize(count);
+                for (size_t i = 0; i < count; ++i) {
+                    if (list_size != 0)
+                        lists[i].reserve(list_size);
+                    for (size_t j = 0; j < list_size; ++j)
+                        lists[i].push_back(static_cast<uint32_t>(i + j));
+                }
+                watch.stop();
+            }).ns_per_op;
+            rss = rss_mb() - base;
+            scan_ns = bench::measure(3, count, [&] (Stopwatch& watch) {
+                uint64_t total = 0;
+                watch.start();
+                for (const List& list : lists)
+                    total += list.size();
+                watch.stop();
+                bench::keep(total);
+            }).ns_per_op;
+        }
+#ifdef __GLIBC__
+        malloc_trim(0);
+#endif
+        printf("%-14s %6zu %12zu %10zu %14.2f %12.1f %10.2f %10.2f\n", container, sizeof(List), list_size, count,
+            static_cast<double>(bench::alloc_stats.bytes) / count, rss, build_ns, scan_ns);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = 10000000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--count N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (count == 0)
+        count = 1;
+    using Alloc = bench::CountingAllocator<uint32_t>;
+    printf("%-14s %6s %12s %10s %14s %12s %10s %10s\n", "container", "sizeof", "list size", "count", "heap B/list",
+        "RSS MB", "build ns", "scan ns");
+    for (size_t list_size : LIST_SIZES) {
+        run<Vector<uint32_t, Alloc>>("Vector", count, list_size);
+        run<CompactVector<uint32_t, Alloc>>("CompactVector", count, list_size);
+    }
+    return 0;
+}
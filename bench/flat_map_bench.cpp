@@ -0,0 +1,112 @@
+#include "bench_util.hpp"
+#include "../src/flat_map.hpp"
+#include "../src/vector.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    const size_t LOOKUPS = 1 << 20;
+    const size_t ONE_BY_ONE_LIMIT = 100000;
+
+    Vector<std::pair<uint64_t, uint64_t>> make_pairs(size_t cnt, uint64_t seed) {
+        std::mt19937_64 gen(seed);
+        Vector<std::pair<uint64_t, uint64_t>> res;
+        res.reserve(cnt);
+        for (size_t i = 0; i < cnt; ++i)
+            res.emplace_back(gen(), i);
+        return res;
+    }
+
+    Vector<uint64_t> make_queries(const Vector<std::pair<uint64_t, uint64_t>>& pairs) {
+        std::mt19937_64 gen(pairs.size());
+        Vector<uint64_t> res;
+        res.reserve(LOOKUPS);
+        for (size_t i = 0; i < LOOKUPS; ++i)
+            res.push_back(i % 2 == 0 ? pairs[gen() % pairs.size()].first : gen());
+        return res;
+    }
+
+    template <class Build>
+    Sample insert(size_t cnt, Build&& build) {
+        return bench::measure(1, cnt, [&] (Stopwatch& watch) {
+            watch.start();
+            build();
+            watch.stop();
+        });
+    }
+
+    template <class Find>
+    Sample lookup(const Vector<uint64_t>& queries, Find&& find) {
+        return bench::measure(1, queries.size(), [&] (Stopwatch& watch) {
+            uint64_t total = 0;
+            watch.start();
+            for (uint64_t key : queries)
+                total += find(key);
+            watch.stop();
+            bench::keep(total);
+        });
+    }
+
+    void report(const char* container, const char* op, size_t cnt, const Sample& sample) {
+        printf("%-20s %-12s %10zu %12.2f\n", container, op, cnt, sample.ns_per_op);
+    }
+
+    void run(size_t cnt) {
+        auto pairs = make_pairs(cnt, cnt);
+        auto queries = make_queries(pairs);
+        FlatMap<uint64_t, uint64_t> flat;
+        std::map<uint64_t, uint64_t> tree;
+        std::unordered_map<uint64_t, uint64_t> hash;
+        report("FlatMap", "insert_bulk", cnt, insert(cnt, [&] { flat.insert_bulk(pairs); }));
+        report("std::map", "insert", cnt, insert(cnt, [&] { tree.insert(pairs.begin(), pairs.end()); }));
+        report("std::unordered_map", "insert", cnt, insert(cnt, [&] {
+            hash.reserve(cnt);
+            hash.insert(pairs.begin(), pairs.end());
+        }));
+        if (cnt <= ONE_BY_ONE_LIMIT) {
+            report("FlatMap", "insert", cnt, insert(cnt, [&] {
+                FlatMap<uint64_t, uint64_t> one_by_one;
+                for (const auto& [key, val] : pairs)
+                    one_by_one.insert(key, val);
+                bench::keep(one_by_one.size());
+            }));
+        }
+        report("FlatMap", "find", cnt, lookup(queries, [&] (uint64_t key) {
+            const uint64_t* res = flat.find(key);
+            return res == nullptr ? 0 : *res;
+        }));
+        report("std::map", "find", cnt, lookup(queries, [&] (uint64_t key) {
+            auto res = tree.find(key);
+            return res == tree.end() ? 0 : res->second;
+        }));
+        report("std::unordered_map", "find", cnt, lookup(queries, [&] (uint64_t key) {
+            auto res = hash.find(key);
+            return res == hash.end() ? 0 : res->second;
+        }));
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_size = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--max-size N]\n", argv[0]);
+            return 2;
+        }
+    }
+    printf("%-20s %-12s %10s %12s\n", "container", "op", "keys", "ns/op");
+    for (size_t cnt = 1000; cnt <= max_size && cnt <= 10000000; cnt *= 10)
+        run(cnt);
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "bench_util.hpp"
+#include "../src/gap_vector.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    const uint32_t JUMP_PERCENT = 2;
+    const uint32_t ERASE_PERCENT = 30;
+    const int32_t MAX_STEP = 8;
+
+    struct Edit {
+        bool erase;
+        uint32_t pos;
+        char ch;
+    };
+
+    Vector<Edit> make_trace(size_t doc_size, size_t ops) {
+        std::mt19937 gen(doc_size);
+        Vector<Edit> res;
+        res.reserve(ops);
+        size_t size = doc_size;
+        size_t cursor = gen() % (size + 1);
+        for (size_t i = 0; i < ops; ++i) {
+            if (gen() % 100 < JUMP_PERCENT) {
+                cursor = gen() % (size + 1);
+            } else {
+                int64_t step = static_cast<int64_t>(gen() % (2 * MAX_STEP + 1)) - MAX_STEP;
+                cursor = std::clamp<int64_t>(static_cast<int64_t>(cursor) + step, 0, size);
+            }
+            if (cursor > 0 && gen() % 100 < ERASE_PERCENT) {
+                --cursor;
+                --size;
+                res.push_back({true, static_cast<uint32_t>(cursor), 0});
+            } else {
+                res.push_back({false, static_cast<uint32_t>(cursor), static_cast<char>('a' + gen() % 26)});
+                ++cursor;
+                ++size;
+            }
+        }
+        return res;
+    }
+
+    void apply(Vector<char>& text, const Edit& edit) {
+        if (edit.erase)
+            text.erase(text.begin() + edit.pos);
+        else
+            text.insert(text.begin() + edit.pos, edit.ch);
+    }
+
+    void apply(GapVector<char>& text, const Edit& edit) {
+        if (edit.erase)
+            text.erase(edit.pos);
+        else
+            text.insert(edit.pos, edit.ch);
+    }
+
+    template <class Text>
+    Sample run_replay(size_t doc_size, const Vector<Edit>& trace, Text& out) {
+        return bench::measure(1, trace.size(), [&] (Stopwatch& watch) {
+            Text text(doc_size, 'x');
+            watch.start();
+            for (const Edit& edit : trace)
+                apply(text, edit);
+            watch.stop();
+            out = std::move(text);
+        });
+    }
+
+    template <class Text>
+    Sample run_scan(const Text& text) {
+        return bench::measure(5, text.size(), [&] (Stopwatch& watch) {
+            uint64_t total = 0;
+            watch.start();
+            for (char ch : text)
+                total += ch;
+            watch.stop();
+            bench::keep(total);
+        });
+    }
+
+    void report(const char* container, const char* op, size_t doc_size, const Sample& sample) {
+        printf("%-12s %-12s %10zu %12.2f\n", container, op, doc_size, sample.ns_per_op);
+    }
+
+    void run(size_t doc_size, size_t ops) {
+        Vector<Edit> trace = make_trace(doc_size, ops);
+        Vector<char> flat;
+        GapVector<char> gap;
+        report("Vector", "replay", doc_size, run_replay(doc_size, trace, flat));
+        report("GapVector", "replay", doc_size, run_replay(doc_size, trace, gap));
+        report("Vector", "scan", doc_size, run_scan(flat));
+        report("GapVector", "scan", doc_size, run_scan(gap));
+        gap.move_gap(gap.size() / 2);
+        report("GapVector", "contiguous", doc_size, bench::measure(1, gap.size(), [&] (Stopwatch& watch) {
+            watch.start();
+            auto span = gap.contiguous();
+            watch.stop();
+            bench::keep(span.data());
+        }));
+        if (!std::ranges::equal(flat, gap.contiguous())) {
+            fprintf(stderr, "replay mismatch at %zu\n", doc_size);
+            exit(1);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_size = 1000000;
+    size_t ops = 100000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+            ops = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--max-size N] [--ops N]\n", argv[0]);
+            return 2;
+        }
+    }
+    printf("%-12s %-12s %10s %12s\n", "container", "op", "doc size", "ns/op");
+    for (size_t doc_size = 1000; doc_size <= max_size && doc_size <= 100000000; doc_size *= 10)
+        run(doc_size, ops);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include "bench_util.hpp"
+#include "../src/inplace_vector.hpp"
+#include "../src/vector.hpp"
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    using bench::CountingAllocator;
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    const size_t CAPACITY = 32;
+    const size_t MESSAGES = 1 << 20;
+
+    template <class C, class Prepare, class Push>
+    Sample parse_messages(size_t fields, Prepare&& prepare, Push&& push) {
+        return bench::measure(1, MESSAGES, [&] (Stopwatch& watch) {
+            uint64_t total = 0;
+            watch.start();
+            for (size_t msg = 0; msg < MESSAGES; ++msg) {
+                C cont;
+                prepare(cont);
+                for (size_t i = 0; i < fields; ++i)
+                    push(cont, static_cast<uint32_t>(msg ^ i));
+                for (uint32_t field : cont)
+                    total += field;
+            }
+            watch.stop();
+            bench::keep(total);
+        });
+    }
+
+    void report(const char* name, size_t fields, const Sample& sample) {
+        printf("%-28s %8zu %12.2f %10.2f\n", name, fields, sample.ns_per_op, sample.allocations / MESSAGES);
+    }
+}
+
+int main() {
+    using Inplace = InplaceVector<uint32_t, CAPACITY>;
+    using Heap = Vector<uint32_t, CountingAllocator<uint32_t>>;
+    auto no_prepare = [] (auto&) {};
+    printf("%-28s %8s %12s %10s\n", "container", "fields", "ns/message", "allocs/msg");
+    for (size_t fields : {4, 16, 32}) {
+        report("Vector reserve(N)", fields, parse_messages<Heap>(fields,
+            [] (Heap& cont) { cont.reserve(CAPACITY); },
+            [] (Heap& cont, uint32_t val) { cont.push_back(val); }));
+        report("InplaceVector push_back", fields, parse_messages<Inplace>(fields, no_prepare,
+            [] (Inplace& cont, uint32_t val) { cont.push_back(val); }));
+        report("InplaceVector try_push_back", fields, parse_messages<Inplace>(fields, no_prepare,
+            [] (Inplace& cont, uint32_t val) { cont.try_push_back(val); }));
+        report("InplaceVector unchecked", fields, parse_messages<Inplace>(fields, no_prepare,
+            [] (Inplace& cont, uint32_t val) { cont.unchecked_push_back(val); }));
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "bench_util.hpp"
+#include "../src/jagged_vector.hpp"
+#include "../src/vector.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <utility>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    using Edges = Vector<std::pair<uint32_t, uint32_t>>;
+    using Nested = Vector<Vector<uint32_t>>;
+    using Jagged = JaggedVector<uint32_t>;
+
+    const uint32_t UNVISITED = UINT32_MAX;
+
+    Edges make_edges(size_t vertices, size_t degree) {
+        std::mt19937_64 gen(vertices);
+        Edges res;
+        res.reserve(vertices * degree);
+        for (size_t i = 0; i < vertices * degree; ++i)
+            res.emplace_back(gen() % vertices, gen() % vertices);
+        return res;
+    }
+
+    Nested build_nested(size_t vertices, const Edges& edges) {
+        Nested res(vertices);
+        for (const auto& [from, to] : edges)
+            res[from].push_back(to);
+        return res;
+    }
+
+    template <class Graph>
+    size_t bfs(const Graph& graph, Vector<uint32_t>& dist, Vector<uint32_t>& queue) {
+        dist.assign(graph.size(), UNVISITED);
+        queue.clear();
+        queue.push_back(0);
+        dist[0] = 0;
+        size_t edges = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            uint32_t from = queue[head];
+            for (uint32_t to : graph[from]) {
+                ++edges;
+                if (dist[to] == UNVISITED) {
+                    dist[to] = dist[from] + 1;
+                    queue.push_back(to);
+                }
+            }
+        }
+        return edges;
+    }
+
+    template <class Graph>
+    Sample run_bfs(const Graph& graph, size_t edge_cnt) {
+        Vector<uint32_t> dist(graph.size());
+        Vector<uint32_t> queue;
+        queue.reserve(graph.size());
+        return bench::measure(3, edge_cnt, [&] (Stopwatch& watch) {
+            watch.start();
+            size_t edges = bfs(graph, dist, queue);
+            watch.stop();
+            bench::keep(edges);
+        });
+    }
+
+    template <class Graph>
+    Sample run_iterate(const Graph& graph, size_t edge_cnt) {
+        return bench::measure(3, edge_cnt, [&] (Stopwatch& watch) {
+            uint64_t total = 0;
+            watch.start();
+            for (const auto& row : graph)
+                for (uint32_t val : row)
+                    total += val;
+            watch.stop();
+            bench::keep(total);
+        });
+    }
+
+    template <class Build>
+    Sample run_build(size_t edge_cnt, Build&& build) {
+        return bench::measure(1, edge_cnt, [&] (Stopwatch& watch) {
+            watch.start();
+            auto graph = build();
+            watch.stop();
+            bench::keep(graph.size());
+        });
+    }
+
+    void report(const char* container, const char* op, size_t vertices, const Sample& sample) {
+        printf("%-20s %-10s %10zu %12.2f\n", container, op, vertices, sample.ns_per_op);
+    }
+
+    void run(size_t vertices, size_t degree) {
+        Edges edges = make_edges(vertices, degree);
+        Nested nested = build_nested(vertices, edges);
+        Jagged jagged = Jagged::from_pairs(vertices, edges);
+        report("Vector<Vector>", "build", vertices, run_build(edges.size(), [&] {
+            return build_nested(vertices, edges);
+        }));
+        report("JaggedVector", "build", vertices, run_build(edges.size(), [&] {
+            return Jagged::from_pairs(vertices, edges);
+        }));
+        report("Vector<Vector>", "bfs", vertices, run_bfs(nested, edges.size()));
+        report("JaggedVector", "bfs", vertices, run_bfs(jagged, edges.size()));
+        report("Vector<Vector>", "iterate", vertices, run_iterate(nested, edges.size()));
+        report("JaggedVector", "iterate", vertices, run_iterate(jagged, edges.size()));
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_size = 1000000;
+    size_t degree = 8;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--max-size N] [--degree N]\n", argv[0]);
+            return 2;
+        }
+    }
+    printf("%-20s %-10s %10s %12s\n", "container", "op", "vertices", "ns/edge");
+    for (size_t vertices = 1000; vertices <= max_size && vertices <= 10000000; vertices *= 10)
+        run(vertices, degree);
+    return 0;
+}
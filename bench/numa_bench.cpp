@@ -0,0 +1,108 @@
+#include "bench_util.hpp"
+#include "../src/numa_allocator.hpp"
+#include "../src/vector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const size_t DEFAULT_SIZE_MB = 256;
+    const size_t SUM_REPS = 5;
+
+    struct Options {
+        size_t size_mb = DEFAULT_SIZE_MB;
+        size_t threads = std::thread::hardware_concurrency();
+    };
+
+    double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    double parallel_sum_gbps(std::span<const uint64_t> data, size_t workers) {
+        std::atomic<uint64_t> total{0};
+        Clock::time_point start = Clock::now();
+        for (size_t rep = 0; rep < SUM_REPS; ++rep) {
+            Vector<std::thread> threads;
+            for (size_t w = 0; w < workers; ++w) {
+                threads.emplace_back([&, w] {
+                    size_t first = data.size() * w / workers;
+                    size_t last = data.size() * (w + 1) / workers;
+                    uint64_t sum = 0;
+                    for (size_t i = first; i < last; ++i)
+                        sum += data[i];
+                    total += sum;
+                });
+            }
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+        bench::keep(total);
+        return static_cast<double>(data.size_bytes() * SUM_REPS) / seconds_since(start) / 1e9;
+    }
+
+    void report(const char* name, double init_ms, double gbps) {
+        printf("%-24s %12.2f %12.2f\n", name, init_ms, gbps);
+    }
+
+    void run_serial(size_t cnt, size_t workers) {
+        Clock::time_point start = Clock::now();
+        Vector<uint64_t> data(cnt, 1);
+        double init_ms = seconds_since(start) * 1e3;
+        report("std::allocator serial", init_ms, parallel_sum_gbps(data, workers));
+    }
+
+    void run_numa(const char* name, numa::Policy policy, size_t cnt, size_t workers) {
+        using Alloc = NumaAllocator<uint64_t>;
+        Clock::time_point start = Clock::now();
+        Vector<uint64_t, Alloc> data(cnt, Alloc(policy));
+        numa::first_touch(std::span<uint64_t>(data.data(), data.size()), workers, [] (std::span<uint64_t> slice, size_t) {
+            for (uint64_t& val : slice)
+                val = 1;
+        });
+        double init_ms = seconds_since(start) * 1e3;
+        report(name, init_ms, parallel_sum_gbps(std::span<const uint64_t>(data.data(), data.size()), workers));
+    }
+
+    bool parse_options(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            bool has_value = i + 1 < argc;
+            if (strcmp(argv[i], "--size-mb") == 0 && has_value)
+                opts.size_mb = strtoull(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--threads") == 0 && has_value)
+                opts.threads = strtoull(argv[++i], nullptr, 10);
+            else
+                return false;
+        }
+        if (opts.threads == 0)
+            opts.threads = 1;
+        return opts.size_mb != 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parse_options(argc, argv, opts)) {
+        fprintf(stderr, "usage: %s [--size-mb N] [--threads N]\n", argv[0]);
+        return 2;
+    }
+    size_t cnt = opts.size_mb * (1 << 20) / sizeof(uint64_t);
+    printf("nodes: %zu, threads: %zu, size: %zu MB, numa syscalls: %s\n",
+        numa::node_count(), opts.threads, opts.size_mb, numa::supported() ? "yes" : "no");
+    printf("%-24s %12s %12s\n", "placement", "init ms", "sum GB/s");
+    run_serial(cnt, opts.threads);
+    run_numa("numa local + first touch", numa::Policy::LOCAL, cnt, opts.threads);
+    run_numa("numa interleave", numa::Policy::INTERLEAVE, cnt, opts.threads);
+    run_numa("numa partitioned", numa::Policy::PARTITIONED, cnt, opts.threads);
+    numa::Stats stats = numa::stats();
+    printf("mapped allocations: %zu (%zu bytes), policy calls: %zu, failed: %zu, skipped: %zu, touched slices: %zu\n",
+        stats.mapped_allocations, stats.mapped_bytes, stats.policy_calls,
+        stats.policy_failures, stats.policy_skipped, stats.touched_slices);
+    return 0;
+}
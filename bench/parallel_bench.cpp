@@ -0,0 +1,98 @@
+#include "bench_util.hpp"
+#include "../src/parallel.hpp"
+#include "../src/thread_pool.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    Vector<uint64_t> make_keys(size_t cnt) {
+        std::mt19937_64 gen(cnt);
+        Vector<uint64_t> res(cnt);
+        for (uint64_t& key : res)
+            key = gen();
+        return res;
+    }
+
+    template <class F>
+    Sample run_sort(const Vector<uint64_t>& keys, F&& sort) {
+        return bench::measure(3, 1, [&] (Stopwatch& watch) {
+            Vector<uint64_t> vec = keys;
+            watch.start();
+            sort(vec);
+            watch.stop();
+            if (!std::is_sorted(vec.begin(), vec.end())) {
+                fprintf(stderr, "sort produced unsorted output\n");
+                exit(1);
+            }
+        });
+    }
+
+    void report(const char* op, size_t threads, const Sample& sample, double baseline) {
+        printf("%-16s %8zu %12.2f %10.2f\n", op, threads, sample.ns_per_op / 1e6, baseline / sample.ns_per_op);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t size = size_t(1) << 24;
+    size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            max_threads = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--size N] [--max-threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+    Vector<uint64_t> keys = make_keys(size);
+    Sample baseline = run_sort(keys, [] (Vector<uint64_t>& vec) {
+        std::sort(vec.begin(), vec.end());
+    });
+    Sample serial_sum = bench::measure(3, 1, [&] (Stopwatch& watch) {
+        watch.start();
+        uint64_t total = 0;
+        for (uint64_t key : keys)
+            total += key;
+        watch.stop();
+        bench::keep(total);
+    });
+    printf("%-16s %8s %12s %10s\n", "op", "threads", "ms", "speedup");
+    report("std::sort", 1, baseline, baseline.ns_per_op);
+    report("serial sum", 1, serial_sum, serial_sum.ns_per_op);
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        report("radix sort", threads, run_sort(keys, [&] (Vector<uint64_t>& vec) {
+            parallel_radix_sort(vec, pool);
+        }), baseline.ns_per_op);
+        report("merge sort", threads, run_sort(keys, [&] (Vector<uint64_t>& vec) {
+            parallel_sort(vec, std::less<>(), pool);
+        }), baseline.ns_per_op);
+        report("reduce", threads, bench::measure(3, 1, [&] (Stopwatch& watch) {
+            watch.start();
+            uint64_t total = parallel_reduce(keys, uint64_t(0), std::plus<>(), pool);
+            watch.stop();
+            bench::keep(total);
+        }), serial_sum.ns_per_op);
+        Vector<uint64_t> out(size);
+        report("transform", threads, bench::measure(3, 1, [&] (Stopwatch& watch) {
+            watch.start();
+            parallel_transform(keys, out, [] (uint64_t key) {
+                return key * 0x9E3779B97F4A7C15ull >> 7;
+            }, pool);
+            watch.stop();
+            bench::keep(out.data());
+        }), serial_sum.ns_per_op);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "bench_util.hpp"
+#include "../src/pool_allocator.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace {
+    const size_t VECTORS_PER_REQUEST = 16;
+    const size_t MAX_ELEMENTS_SHIFT = 12;
+
+    thread_local size_t allocations = 0;
+
+    template <class T, class Base>
+    class TallyAllocator: public Base {
+    public:
+        using value_type = T;
+        constexpr TallyAllocator() noexcept = default;
+        template <class U, class UBase>
+        constexpr TallyAllocator(const TallyAllocator<U, UBase>&) noexcept {}
+        T* allocate(size_t cnt) {
+            ++allocations;
+            return Base::allocate(cnt);
+        }
+    };
+
+    template <class Vec>
+    struct Mailbox {
+        std::mutex lock;
+        Vector<Vec> items;
+    };
+
+    struct Result {
+        double seconds = 0;
+        size_t allocations = 0;
+        size_t requests = 0;
+        double p50_us = 0;
+        double p99_us = 0;
+        pool::Stats pool_stats;
+    };
+
+    template <class Vec>
+    uint64_t handle(std::mt19937_64& gen, Mailbox<Vec>& inbox, Mailbox<Vec>& outbox) {
+        Vector<Vec> received;
+        {
+            std::lock_guard guard(inbox.lock);
+            received.swap(inbox.items);
+        }
+        uint64_t total = received.size();
+        received.clear();
+        Vec keep;
+        for (size_t i = 0; i < VECTORS_PER_REQUEST; ++i) {
+            size_t cnt = size_t(1) << (gen() % MAX_ELEMENTS_SHIFT);
+            cnt += gen() % cnt;
+            Vec tmp;
+            for (size_t j = 0; j < cnt; ++j)
+                tmp.push_back(j ^ total);
+            total += tmp[cnt / 2];
+            if (i == 0)
+                keep = std::move(tmp);
+        }
+        std::lock_guard guard(outbox.lock);
+        outbox.items.push_back(std::move(keep));
+        return total;
+    }
+
+    template <class Vec>
+    Result run(size_t threads, size_t requests) {
+        Vector<std::unique_ptr<Mailbox<Vec>>> mailboxes;
+        for (size_t i = 0; i < threads; ++i)
+            mailboxes.push_back(std::make_unique<Mailbox<Vec>>());
+        Vector<Vector<double>> latencies(threads);
+        Vector<size_t> counts(threads);
+        Vector<pool::Stats> stats(threads);
+        Vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t w = 0; w < threads; ++w) {
+            workers.emplace_back([&, w] {
+                std::mt19937_64 gen(w + 1);
+                allocations = 0;
+                pool::reset_thread_stats();
+                Vector<double>& lat = latencies[w];
+                lat.reserve(requests);
+                uint64_t total = 0;
+                for (size_t r = 0; r < requests; ++r) {
+                    auto begin = std::chrono::steady_clock::now();
+                    total += handle(gen, *mailboxes[w], *mailboxes[(w + 1) % threads]);
+                    auto end = std::chrono::steady_clock::now();
+                    lat.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+                }
+                bench::keep(total);
+                counts[w] = allocations;
+                stats[w] = pool::thread_stats();
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+        Result res;
+        res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Vector<double> all;
+        for (size_t w = 0; w < threads; ++w) {
+            all.append_range(latencies[w]);
+            res.allocations += counts[w];
+            res.pool_stats.hits += stats[w].hits;
+            res.pool_stats.misses += stats[w].misses;
+            res.pool_stats.remote_frees += stats[w].remote_frees;
+        }
+        res.requests = all.size();
+        std::sort(all.begin(), all.end());
+        res.p50_us = all[all.size() / 2];
+        res.p99_us = all[all.size() * 99 / 100];
+        return res;
+    }
+
+    void report(const char* allocator, size_t threads, const Result& res) {
+        size_t pooled = res.pool_stats.hits + res.pool_stats.misses;
+        double hit_rate = pooled == 0 ? 0 : 100.0 * res.pool_stats.hits / pooled;
+        printf("%-16s %8zu %14.2f %12.2f %10.1f %10.1f %8.1f %10zu\n", allocator, threads,
+            res.allocations / res.seconds / 1e6, res.requests / res.seconds / 1e3, res.p50_us, res.p99_us,
+            hit_rate, res.pool_stats.remote_frees);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_threads = 64;
+    size_t requests = 2000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            max_threads = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+            requests = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--max-threads N] [--requests N]\n", argv[0]);
+            return 2;
+        }
+    }
+    using StdVec = Vector<uint64_t, TallyAllocator<uint64_t, std::allocator<uint64_t>>>;
+    using PoolVec = Vector<uint64_t, TallyAllocator<uint64_t, PoolAllocator<uint64_t>>>;
+    printf("%-16s %8s %14s %12s %10s %10s %8s %10s\n", "allocator", "threads", "Malloc/s", "Kreq/s", "p50 us",
+        "p99 us", "hit %", "remote");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        report("std::allocator", threads, run<StdVec>(threads, requests));
+        report("PoolAllocator", threads, run<PoolVec>(threads, requests));
+    }
+    return 0;
+}
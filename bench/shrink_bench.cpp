@@ -0,0 +1,67 @@
+#include "../src/numa_allocator.hpp"
+#include "../src/vector.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+    const size_t DEFAULT_BURST_MB = 128;
+    const size_t BURSTS = 4;
+    const size_t QUIET_OPS = 1 << 20;
+    const size_t SAMPLES_PER_BURST = 8;
+    const size_t MESSAGE_SIZE = 512;
+
+    double rss_mb() {
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (file == nullptr)
+            return 0;
+        size_t pages = 0;
+        size_t resident = 0;
+        int read = fscanf(file, "%zu %zu", &pages, &resident);
+        fclose(file);
+        return read == 2 ? static_cast<double>(resident * sysconf(_SC_PAGESIZE)) / (1 << 20) : 0;
+    }
+
+    template <class C>
+    Vector<double> run_bursts(C buf, size_t burst_bytes) {
+        Vector<double> samples;
+        for (size_t burst = 0; burst < BURSTS; ++burst) {
+            for (size_t i = 0; i < burst_bytes; ++i)
+                buf.push_back(static_cast<uint8_t>(i));
+            samples.push_back(rss_mb());
+            buf.clear();
+            for (size_t op = 0; op < QUIET_OPS; ++op) {
+                if (buf.size() >= MESSAGE_SIZE)
+                    buf.clear();
+                buf.push_back(static_cast<uint8_t>(op));
+                if ((op + 1) % (QUIET_OPS / (SAMPLES_PER_BURST - 1)) == 0)
+                    samples.push_back(rss_mb());
+            }
+        }
+        return samples;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t burst_mb = DEFAULT_BURST_MB;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--burst-mb") == 0 && i + 1 < argc) {
+            burst_mb = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--burst-mb N]\n", argv[0]);
+            return 2;
+        }
+    }
+    using Shrinking = ShrinkAllocator<uint8_t>;
+    using ShrinkingNuma = ShrinkAllocator<uint8_t, NumaAllocator<uint8_t>>;
+    size_t burst_bytes = burst_mb << 20;
+    Vector<double> plain = run_bursts(Vector<uint8_t>(), burst_bytes);
+    Vector<double> shrinking = run_bursts(Vector<uint8_t, Shrinking>(), burst_bytes);
+    Vector<double> in_place = run_bursts(Vector<uint8_t, ShrinkingNuma>(), burst_bytes);
+    printf("%-8s %14s %14s %14s\n", "sample", "plain MB", "shrink MB", "in-place MB");
+    for (size_t i = 0; i < plain.size(); ++i)
+        printf("%-8zu %14.1f %14.1f %14.1f\n", i, plain[i], shrinking[i], in_place[i]);
+    return 0;
+}
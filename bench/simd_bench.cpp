@@ -0,0 +1,158 @@
+#include "bench_util.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+namespace {
+    using bench::Sample;
+    using bench::Stopwatch;
+    using Lane = float __attribute__((vector_size(16)));
+
+    const size_t LANE_WIDTH = sizeof(Lane) / sizeof(float);
+    const size_t UNROLL = 4;
+    const size_t BLOCK = LANE_WIDTH * UNROLL;
+    const size_t ALIGN = BLOCK * sizeof(float);
+    const size_t SIZES[] = {7, 100, 1001, 10003, 100003, 1000003};
+    const size_t WORK_PER_CASE = 1 << 24;
+
+    float horizontal_sum(const Lane (&acc)[UNROLL]) {
+        Lane total = acc[0] + acc[1] + acc[2] + acc[3];
+        return total[0] + total[1] + total[2] + total[3];
+    }
+
+    Lane load_unaligned(const float* src) {
+        Lane res;
+        memcpy(&res, src, sizeof(res));
+        return res;
+    }
+
+    float sum_unaligned(const float* src, size_t cnt) {
+        Lane acc[UNROLL] = {};
+        size_t i = 0;
+        for (; i + BLOCK <= cnt; i += BLOCK) {
+            for (size_t k = 0; k < UNROLL; ++k)
+                acc[k] += load_unaligned(src + i + k * LANE_WIDTH);
+        }
+        for (; i + LANE_WIDTH <= cnt; i += LANE_WIDTH)
+            acc[0] += load_unaligned(src + i);
+        float res = horizontal_sum(acc);
+        for (; i < cnt; ++i)
+            res += src[i];
+        return res;
+    }
+
+    float dot_unaligned(const float* lhs, const float* rhs, size_t cnt) {
+        Lane acc[UNROLL] = {};
+        size_t i = 0;
+        for (; i + BLOCK <= cnt; i += BLOCK) {
+            for (size_t k = 0; k < UNROLL; ++k)
+                acc[k] += load_unaligned(lhs + i + k * LANE_WIDTH) * load_unaligned(rhs + i + k * LANE_WIDTH);
+        }
+        for (; i + LANE_WIDTH <= cnt; i += LANE_WIDTH)
+            acc[0] += load_unaligned(lhs + i) * load_unaligned(rhs + i);
+        float res = horizontal_sum(acc);
+        for (; i < cnt; ++i)
+            res += lhs[i] * rhs[i];
+        return res;
+    }
+
+    float sum_padded(std::span<const float> src) {
+        const Lane* lanes = static_cast<const Lane*>(__builtin_assume_aligned(src.data(), ALIGN));
+        Lane acc[UNROLL] = {};
+        for (size_t i = 0; i < src.size() / LANE_WIDTH; i += UNROLL) {
+            for (size_t k = 0; k < UNROLL; ++k)
+                acc[k] += lanes[i + k];
+        }
+        return horizontal_sum(acc);
+    }
+
+    float dot_padded(std::span<const float> lhs, std::span<const float> rhs) {
+        const Lane* lhs_lanes = static_cast<const Lane*>(__builtin_assume_aligned(lhs.data(), ALIGN));
+        const Lane* rhs_lanes = static_cast<const Lane*>(__builtin_assume_aligned(rhs.data(), ALIGN));
+        Lane acc[UNROLL] = {};
+        for (size_t i = 0; i < lhs.size() / LANE_WIDTH; i += UNROLL) {
+            for (size_t k = 0; k < UNROLL; ++k)
+                acc[k] += lhs_lanes[i + k] * rhs_lanes[i + k];
+        }
+        return horizontal_sum(acc);
+    }
+
+    template <class C>
+    C make_values(size_t n) {
+        C res;
+        res.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            res.push_back(static_cast<float>(i % 17) * 0.25f);
+        return res;
+    }
+
+    template <class Body>
+    Sample run(size_t n, Body&& body) {
+        size_t reps = n >= WORK_PER_CASE ? 1 : WORK_PER_CASE / n;
+        return bench::measure(reps, n, [&] (Stopwatch& watch) {
+            watch.start();
+            float res = body();
+            watch.stop();
+            bench::keep(res);
+        });
+    }
+
+    template <class T, class Compress>
+    Sample run_compress(size_t n, Compress&& compress) {
+        Vector<T> src(n);
+        Vector<uint64_t> keep((n + 63) / 64);
+        for (size_t i = 0; i < n; ++i) {
+            src[i] = static_cast<T>(i);
+            keep[i / 64] |= uint64_t(i % 7 != 0 && i % 3 != 1) << (i % 64);
+        }
+        Vector<T> dst(n);
+        size_t reps = n >= WORK_PER_CASE ? 1 : WORK_PER_CASE / n;
+        return bench::measure(reps, n, [&] (Stopwatch& watch) {
+            watch.start();
+            size_t write = 0;
+            for (size_t base = 0; base < n; base += 64)
+                write += compress(src.data() + base, keep[base / 64], std::min<size_t>(64, n - base), dst.data() + write);
+            watch.stop();
+            bench::keep(write);
+            bench::keep(dst.data());
+        });
+    }
+
+    template <class T>
+    void report_compress(const char* kernel, size_t n) {
+        printf("%-10s %10zu %16.3f %16.3f\n", kernel, n,
+            run_compress<T>(n, detail::compress_scalar<T>).ns_per_op, run_compress<T>(n, detail::compress<T>).ns_per_op);
+    }
+
+    void report(const char* kernel, size_t n, const Sample& plain, const Sample& padded) {
+        printf("%-6s %10zu %16.3f %16.3f\n", kernel, n, plain.ns_per_op, padded.ns_per_op);
+    }
+}
+
+int main() {
+    printf("%-6s %10s %16s %16s\n", "kernel", "n", "Vector ns/elem", "padded ns/elem");
+    for (size_t n : SIZES) {
+        auto lhs = make_values<Vector<float>>(n);
+        auto rhs = make_values<Vector<float>>(n);
+        auto lhs_padded = make_values<AlignedVector<float, ALIGN>>(n);
+        auto rhs_padded = make_values<AlignedVector<float, ALIGN>>(n);
+        std::span<const float> lhs_span = lhs_padded.padded_span();
+        std::span<const float> rhs_span = rhs_padded.padded_span();
+        report("sum", n,
+            run(n, [&] { return sum_unaligned(lhs.data(), lhs.size()); }),
+            run(n, [&] { return sum_padded(lhs_span); }));
+        report("dot", n,
+            run(n, [&] { return dot_unaligned(lhs.data(), rhs.data(), lhs.size()); }),
+            run(n, [&] { return dot_padded(lhs_span, rhs_span); }));
+    }
+    printf("\n%-10s %10s %16s %16s\n", "compress", "n", "scalar ns/elem", "simd ns/elem");
+    for (size_t n : SIZES) {
+        report_compress<uint32_t>("32-bit", n);
+        report_compress<uint64_t>("64-bit", n);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "../src/soa_vector.hpp"
+#include "../src/vector.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    struct Particle {
+        double x, y, z;
+        double vx, vy, vz;
+        float mass;
+        float charge;
+        uint32_t id;
+        uint32_t flags;
+    };
+
+    using ParticleColumns = SoaVector<double, double, double, double, double, double, float, float, uint32_t, uint32_t>;
+
+    const size_t PARTICLES = 1 << 22;
+    const size_t ROUNDS = 20;
+    const float MASS_LIMIT = 0.5f;
+
+    template <class F>
+    double time_ns_per_elem(F&& func) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ROUNDS; ++i)
+            func();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * PARTICLES);
+    }
+
+    template <class T>
+    void keep(const T& val) {
+        asm volatile("" : : "g"(&val) : "memory");
+    }
+}
+
+int main() {
+    Vector<Particle> aos;
+    ParticleColumns soa;
+    aos.reserve(PARTICLES);
+    soa.reserve(PARTICLES);
+    for (size_t i = 0; i < PARTICLES; ++i) {
+        double pos = static_cast<double>(i);
+        float mass = static_cast<float>(i % 1000) / 1000.0f;
+        uint32_t id = static_cast<uint32_t>(i);
+        aos.push_back(Particle{pos, pos, pos, 1.0, 1.0, 1.0, mass, 0.0f, id, 0});
+        soa.emplace_back(pos, pos, pos, 1.0, 1.0, 1.0, mass, 0.0f, id, 0u);
+    }
+
+    double aos_sum = time_ns_per_elem([&] {
+        double sum = 0;
+        for (const Particle& p : aos)
+            sum += p.x;
+        keep(sum);
+    });
+    double soa_sum = time_ns_per_elem([&] {
+        double sum = 0;
+        for (double x : soa.column<0>())
+            sum += x;
+        keep(sum);
+    });
+
+    Vector<uint32_t> picked;
+    picked.reserve(PARTICLES);
+    double aos_filter = time_ns_per_elem([&] {
+        picked.clear();
+        for (const Particle& p : aos)
+            if (p.mass > MASS_LIMIT)
+                picked.push_back(p.id);
+        keep(picked);
+    });
+    double soa_filter = time_ns_per_elem([&] {
+        picked.clear();
+        auto mass = soa.column<6>();
+        auto ids = soa.column<8>();
+        for (size_t i = 0; i < mass.size(); ++i)
+            if (mass[i] > MASS_LIMIT)
+                picked.push_back(ids[i]);
+        keep(picked);
+    });
+
+    printf("%-12s %12s %12s\n", "loop", "aos ns/elem", "soa ns/elem");
+    printf("%-12s %12.3f %12.3f\n", "field_sum", aos_sum, soa_sum);
+    printf("%-12s %12.3f %12.3f\n", "filter", aos_filter, soa_filter);
+    return 0;
+}
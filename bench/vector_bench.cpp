@@ -0,0 +1,409 @@
+#include "bench_util.hpp"
+#include "../src/vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    using bench::CountingAllocator;
+    using bench::Result;
+    using bench::Sample;
+    using bench::Stopwatch;
+
+    struct Pod64 {
+        uint64_t words[8];
+        constexpr bool operator==(const Pod64& other) const noexcept = default;
+        constexpr auto operator<=>(const Pod64& other) const noexcept = default;
+    };
+
+    const size_t SIZES[] = {8, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    const size_t DEFAULT_MAX_SIZE = 1000000;
+    const size_t WORK_PER_CASE = 1 << 20;
+    const size_t SOURCE_VALUES = 1024;
+    const size_t EDITS_PER_REP = 16;
+
+    size_t reps_for(size_t n) {
+        return n >= WORK_PER_CASE ? 1 : WORK_PER_CASE / n;
+    }
+
+    template <class V>
+    V make_value(size_t i) {
+        if constexpr (std::is_same_v<V, int>) {
+            return static_cast<int>(i);
+        } else if constexpr (std::is_same_v<V, bool>) {
+            return i % 3 == 0;
+        } else if constexpr (std::is_same_v<V, Pod64>) {
+            Pod64 pod{};
+            pod.words[0] = i;
+            return pod;
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            return "value-with-heap-storage-" + std::to_string(i);
+        } else {
+            V nested;
+            for (size_t k = 0; k < 4; ++k)
+                nested.push_back(static_cast<int>(i + k));
+            return nested;
+        }
+    }
+
+    template <class C>
+    C make_container(size_t n) {
+        using V = typename C::value_type;
+        C res;
+        res.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            res.push_back(make_value<V>(i % SOURCE_VALUES));
+        return res;
+    }
+
+    template <class C>
+    Sample run_push_back(size_t n, bool reserve) {
+        using V = typename C::value_type;
+        std::vector<V> source;
+        for (size_t i = 0; i < SOURCE_VALUES; ++i)
+            source.push_back(make_value<V>(i));
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            C cont;
+            watch.start();
+            if (reserve)
+                cont.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+                cont.push_back(source[i % SOURCE_VALUES]);
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_construct(size_t n, bool fill) {
+        using V = typename C::value_type;
+        V val = make_value<V>(n);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            watch.start();
+            C cont = fill ? C(n, val) : C(n);
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_resize(size_t n) {
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            C cont;
+            cont.reserve(n);
+            watch.start();
+            cont.resize(n);
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_append_range(size_t n) {
+        using V = typename C::value_type;
+        std::vector<V> source;
+        for (size_t i = 0; i < n; ++i)
+            source.push_back(make_value<V>(i % SOURCE_VALUES));
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            C cont;
+            watch.start();
+            if constexpr (requires { cont.append_range(source); })
+                cont.append_range(source);
+            else
+                cont.insert(cont.end(), source.begin(), source.end());
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_copy(size_t n) {
+        C source = make_container<C>(n);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            watch.start();
+            C copy(source);
+            watch.stop();
+            bench::keep(copy);
+        });
+    }
+
+    template <class C>
+    Sample run_compare(size_t n) {
+        C lhs = make_container<C>(n);
+        C rhs = make_container<C>(n);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            watch.start();
+            bool equal = lhs == rhs;
+            watch.stop();
+            bench::keep(equal);
+        });
+    }
+
+    template <class C>
+    Sample run_insert(size_t n, bool middle) {
+        using V = typename C::value_type;
+        C source = make_container<C>(n);
+        V val = make_value<V>(n);
+        return bench::measure(reps_for(n), EDITS_PER_REP, [&] (Stopwatch& watch) {
+            C cont(source);
+            watch.start();
+            for (size_t i = 0; i < EDITS_PER_REP; ++i)
+                cont.insert(cont.begin() + (middle ? cont.size() / 2 : 0), val);
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_erase(size_t n, bool middle) {
+        C source = make_container<C>(n + EDITS_PER_REP);
+        return bench::measure(reps_for(n), EDITS_PER_REP, [&] (Stopwatch& watch) {
+            C cont(source);
+            watch.start();
+            for (size_t i = 0; i < EDITS_PER_REP; ++i)
+                cont.erase(cont.begin() + (middle ? cont.size() / 2 : 0));
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_erase_mask(size_t n) {
+        C source = make_container<C>(n);
+        Vector<bool> mask;
+        std::vector<bool> std_mask;
+        for (size_t i = 0; i < n; ++i) {
+            mask.push_back(i % 7 == 0 || i % 3 == 1);
+            std_mask.push_back(mask.back());
+        }
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            C cont(source);
+            watch.start();
+            if constexpr (requires { cont.erase_mask(mask); }) {
+                cont.erase_mask(mask);
+            } else {
+                size_t idx = 0;
+                cont.erase(std::remove_if(cont.begin(), cont.end(), [&] (const auto&) {
+                    return std_mask[idx++];
+                }), cont.end());
+            }
+            watch.stop();
+            bench::keep(cont);
+        });
+    }
+
+    template <class C>
+    Sample run_bool_read(size_t n) {
+        C bits;
+        for (size_t i = 0; i < n; ++i)
+            bits.push_back(i % 3 == 0);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            size_t cnt = 0;
+            watch.start();
+            for (size_t i = 0; i < n; ++i)
+                cnt += bits[i];
+            watch.stop();
+            bench::keep(cnt);
+        });
+    }
+
+    template <class C>
+    Sample run_bool_iterate(size_t n) {
+        C bits;
+        for (size_t i = 0; i < n; ++i)
+            bits.push_back(i % 3 == 0);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            size_t cnt = 0;
+            watch.start();
+            for (auto it = bits.begin(); it != bits.end(); ++it)
+                cnt += *it;
+            watch.stop();
+            bench::keep(cnt);
+        });
+    }
+
+    template <class C>
+    Sample run_bool_flip(size_t n) {
+        C bits(n, true);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            watch.start();
+            bits.flip();
+            watch.stop();
+            bench::keep(bits);
+        });
+    }
+
+    template <class C>
+    Sample run_bool_export(size_t n) {
+        C bits;
+        for (size_t i = 0; i < n; ++i)
+            bits.push_back(i % 3 == 0);
+        std::vector<std::byte> out((n + 7) / 8);
+        return bench::measure(reps_for(n), n, [&] (Stopwatch& watch) {
+            watch.start();
+            if constexpr (requires { bits.to_bytes(out); }) {
+                bits.to_bytes(out);
+            } else {
+                std::fill(out.begin(), out.end(), std::byte(0));
+                for (size_t i = 0; i < n; ++i)
+                    out[i / 8] |= std::byte(bits[i] ? 1 : 0) << (i % 8);
+            }
+            watch.stop();
+            bench::keep(out);
+        });
+    }
+
+    struct Options {
+        size_t max_size = DEFAULT_MAX_SIZE;
+        const char* json = nullptr;
+        const char* filter = nullptr;
+        bool perf = false;
+    };
+
+    class Suite {
+    public:
+        explicit Suite(const Options& opts) : opts(opts) {}
+
+        template <class F>
+        void add(const char* op, const char* type, size_t n, F&& run) {
+            if (opts.filter != nullptr && strstr(op, opts.filter) == nullptr)
+                return;
+            Result res{op, type, n, run(true), run(false)};
+            bench::print_result(res);
+            fflush(stdout);
+            results.push_back(res);
+        }
+
+        template <class VecT, class StdT>
+        void add_type(const char* type, size_t n) {
+            using Vec = Vector<VecT, CountingAllocator<VecT>>;
+            using Std = std::vector<StdT, CountingAllocator<StdT>>;
+            auto both = [] (auto run_vec, auto run_std) {
+                return [=] (bool vec) { return vec ? run_vec() : run_std(); };
+            };
+            add("push_back", type, n, both(
+                [n] { return run_push_back<Vec>(n, false); },
+                [n] { return run_push_back<Std>(n, false); }));
+            add("reserve_push_back", type, n, both(
+                [n] { return run_push_back<Vec>(n, true); },
+                [n] { return run_push_back<Std>(n, true); }));
+            add("value_construct", type, n, both(
+                [n] { return run_construct<Vec>(n, false); },
+                [n] { return run_construct<Std>(n, false); }));
+            add("fill_construct", type, n, both(
+                [n] { return run_construct<Vec>(n, true); },
+                [n] { return run_construct<Std>(n, true); }));
+            add("resize", type, n, both(
+                [n] { return run_resize<Vec>(n); },
+                [n] { return run_resize<Std>(n); }));
+            add("append_range", type, n, both(
+                [n] { return run_append_range<Vec>(n); },
+                [n] { return run_append_range<Std>(n); }));
+            add("copy", type, n, both(
+                [n] { return run_copy<Vec>(n); },
+                [n] { return run_copy<Std>(n); }));
+            add("compare", type, n, both(
+                [n] { return run_compare<Vec>(n); },
+                [n] { return run_compare<Std>(n); }));
+            add("insert_front", type, n, both(
+                [n] { return run_insert<Vec>(n, false); },
+                [n] { return run_insert<Std>(n, false); }));
+            add("insert_middle", type, n, both(
+                [n] { return run_insert<Vec>(n, true); },
+                [n] { return run_insert<Std>(n, true); }));
+            add("erase_mask", type, n, both(
+                [n] { return run_erase_mask<Vec>(n); },
+                [n] { return run_erase_mask<Std>(n); }));
+            add("erase_front", type, n, both(
+                [n] { return run_erase<Vec>(n, false); },
+                [n] { return run_erase<Std>(n, false); }));
+            add("erase_middle", type, n, both(
+                [n] { return run_erase<Vec>(n, true); },
+                [n] { return run_erase<Std>(n, true); }));
+        }
+
+        void add_bool(size_t n) {
+            using Vec = Vector<bool, CountingAllocator<bool>>;
+            using Std = std::vector<bool, CountingAllocator<bool>>;
+            add("push_back", "bool", n, [n] (bool vec) {
+                return vec ? run_push_back<Vec>(n, false) : run_push_back<Std>(n, false);
+            });
+            add("read", "bool", n, [n] (bool vec) {
+                return vec ? run_bool_read<Vec>(n) : run_bool_read<Std>(n);
+            });
+            add("iterate", "bool", n, [n] (bool vec) {
+                return vec ? run_bool_iterate<Vec>(n) : run_bool_iterate<Std>(n);
+            });
+            add("flip", "bool", n, [n] (bool vec) {
+                return vec ? run_bool_flip<Vec>(n) : run_bool_flip<Std>(n);
+            });
+            add("to_bytes", "bool", n, [n] (bool vec) {
+                return vec ? run_bool_export<Vec>(n) : run_bool_export<Std>(n);
+            });
+            add("copy", "bool", n, [n] (bool vec) {
+                return vec ? run_copy<Vec>(n) : run_copy<Std>(n);
+            });
+        }
+
+        bool finish() const {
+            if (opts.json == nullptr)
+                return true;
+            return bench::write_json(opts.json, "vector_bench", results);
+        }
+    private:
+        Options opts;
+        std::vector<Result> results;
+    };
+
+    bool parse_options(int argc, char** argv, Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            bool has_value = i + 1 < argc;
+            if (strcmp(argv[i], "--max-size") == 0 && has_value)
+                opts.max_size = strtoull(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--json") == 0 && has_value)
+                opts.json = argv[++i];
+            else if (strcmp(argv[i], "--filter") == 0 && has_value)
+                opts.filter = argv[++i];
+            else if (strcmp(argv[i], "--perf") == 0)
+                opts.perf = true;
+            else
+                return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parse_options(argc, argv, opts)) {
+        fprintf(stderr, "usage: %s [--max-size N] [--json PATH] [--filter OP] [--perf]\n", argv[0]);
+        return 2;
+    }
+    PerfCounters counters;
+    if (opts.perf) {
+        if (!counters.available())
+            fprintf(stderr, "hardware performance counters are unavailable, reporting timings only\n");
+        bench::perf_counters = &counters;
+    }
+    Suite suite(opts);
+    bench::print_header();
+    for (size_t n : SIZES) {
+        if (n > opts.max_size)
+            break;
+        suite.add_type<int, int>("int", n);
+        suite.add_type<Pod64, Pod64>("pod64", n);
+        suite.add_type<std::string, std::string>("string", n);
+        suite.add_type<Vector<int>, std::vector<int>>("nested", n);
+        suite.add_bool(n);
+    }
+    if (!suite.finish()) {
+        fprintf(stderr, "cannot write %s\n", opts.json);
+        return 1;
+    }
+    return 0;
+}
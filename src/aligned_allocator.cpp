@@ -0,0 +1,33 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "aligned_allocator.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <new>
+
+template <class T, size_t Align>
+template <class U>
+constexpr AlignedAllocator<T, Align>::AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+template <class T, size_t Align>
+auto AlignedAllocator<T, Align>::padded_bytes(size_t cnt) noexcept -> size_t {
+    return (cnt * sizeof(T) + Align - 1) / Align * Align;
+}
+
+template <class T, size_t Align>
+auto AlignedAllocator<T, Align>::allocate(size_t cnt) -> T* {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0 && Align >= alignof(T));
+    return static_cast<T*>(::operator new(padded_bytes(cnt), std::align_val_t(Align)));
+}
+
+template <class T, size_t Align>
+auto AlignedAllocator<T, Align>::deallocate(T* ptr, size_t cnt) noexcept -> void {
+    ::operator delete(ptr, padded_bytes(cnt), std::align_val_t(Align));
+}
+
+template <class T, size_t Align>
+template <class U>
+constexpr auto AlignedAllocator<T, Align>::operator==(const AlignedAllocator<U, Align>&) const noexcept -> bool {
+    return true;
+}
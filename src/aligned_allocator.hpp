@@ -0,0 +1,33 @@
+#ifndef ALIGNED_ALLOCATOR_H
+
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+
+template <class T, size_t Align = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+    template <class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+    static const size_t alignment = Align;
+    constexpr AlignedAllocator() noexcept = default;
+    template <class U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Align>& other) noexcept;
+    T* allocate(size_t cnt);
+    void deallocate(T* ptr, size_t cnt) noexcept;
+    template <class U>
+    constexpr bool operator==(const AlignedAllocator<U, Align>& other) const noexcept;
+private:
+    static size_t padded_bytes(size_t cnt) noexcept;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "aligned_allocator.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "atomic_bits.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+static_assert(std::atomic_ref<uint64_t>::required_alignment <= alignof(uint64_t));
+static_assert(std::atomic_ref<uint64_t>::is_always_lock_free);
+
+constexpr AtomicBitView::AtomicBitView(std::span<uint64_t> words, size_t bits) noexcept
+: ptr(words.data()), sz(bits) {}
+
+template <class Alloc>
+constexpr AtomicBitView::AtomicBitView(Vector<bool, Alloc>& bits) noexcept
+: AtomicBitView(bits.words(), bits.size()) {}
+
+constexpr auto AtomicBitView::size() const noexcept -> size_t {
+    return sz;
+}
+
+constexpr auto AtomicBitView::words() const noexcept -> std::span<uint64_t> {
+    return {ptr, (sz + BITS_IN_WORD - 1) / BITS_IN_WORD};
+}
+
+constexpr auto AtomicBitView::mask_of(size_t idx) noexcept -> uint64_t {
+    return uint64_t(1) << (idx % BITS_IN_WORD);
+}
+
+constexpr auto AtomicBitView::valid_bits(size_t word_idx) const noexcept -> uint64_t {
+    if (word_idx + 1 == words().size() && sz % BITS_IN_WORD != 0)
+        return (uint64_t(1) << (sz % BITS_IN_WORD)) - 1;
+    return ~uint64_t(0);
+}
+
+inline auto AtomicBitView::word_ref(size_t word_idx) const noexcept -> std::atomic_ref<uint64_t> {
+    return std::atomic_ref<uint64_t>(ptr[word_idx]);
+}
+
+inline auto AtomicBitView::test(size_t idx, std::memory_order order) const noexcept -> bool {
+    return (word_ref(idx / BITS_IN_WORD).load(order) & mask_of(idx)) != 0;
+}
+
+inline auto AtomicBitView::test_and_set(size_t idx, std::memory_order order) const noexcept -> bool {
+    return (word_ref(idx / BITS_IN_WORD).fetch_or(mask_of(idx), order) & mask_of(idx)) != 0;
+}
+
+inline auto AtomicBitView::test_and_reset(size_t idx, std::memory_order order) const noexcept -> bool {
+    return (word_ref(idx / BITS_IN_WORD).fetch_and(~mask_of(idx), order) & mask_of(idx)) != 0;
+}
+
+inline auto AtomicBitView::load_word(size_t word_idx, std::memory_order order) const noexcept -> uint64_t {
+    return word_ref(word_idx).load(order);
+}
+
+inline auto AtomicBitView::fetch_or(size_t word_idx, uint64_t mask, std::memory_order order) const noexcept
+-> uint64_t {
+    return word_ref(word_idx).fetch_or(mask & valid_bits(word_idx), order);
+}
+
+inline auto AtomicBitView::fetch_and(size_t word_idx, uint64_t mask, std::memory_order order) const noexcept
+-> uint64_t {
+    return word_ref(word_idx).fetch_and(mask, order);
+}
+
+inline auto AtomicBitView::count_words(size_t first, size_t last) const noexcept -> size_t {
+    size_t res = 0;
+    for (size_t i = first; i < last; ++i) {
+        res += std::popcount(word_ref(i).load(std::memory_order_relaxed) & valid_bits(i));
+    }
+    return res;
+}
+
+inline auto AtomicBitView::count() const noexcept -> size_t {
+    return count_words(0, words().size());
+}
+
+inline auto AtomicBitView::count(ThreadPool& pool) const -> size_t {
+    std::atomic<size_t> res{0};
+    pool.parallel_for(0, words().size(), COUNT_GRAIN, [&] (size_t first, size_t last) {
+        res.fetch_add(count_words(first, last), std::memory_order_relaxed);
+    });
+    return res.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,47 @@
+#ifndef ATOMIC_BITS_H
+
+#define ATOMIC_BITS_H
+
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class AtomicBitView {
+public:
+    constexpr AtomicBitView() noexcept = default;
+    constexpr AtomicBitView(std::span<uint64_t> words, size_t bits) noexcept;
+    template <class Alloc>
+    explicit constexpr AtomicBitView(Vector<bool, Alloc>& bits) noexcept;
+    constexpr size_t size() const noexcept;
+    constexpr std::span<uint64_t> words() const noexcept;
+    bool test(size_t idx, std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    bool test_and_set(size_t idx, std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    bool test_and_reset(size_t idx, std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    uint64_t load_word(size_t word_idx, std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    uint64_t fetch_or(size_t word_idx, uint64_t mask,
+        std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    uint64_t fetch_and(size_t word_idx, uint64_t mask,
+        std::memory_order order = std::memory_order_seq_cst) const noexcept;
+    size_t count() const noexcept;
+    size_t count(ThreadPool& pool) const;
+private:
+    static const size_t BITS_IN_WORD = 64;
+    static const size_t COUNT_GRAIN = 4096;
+    static constexpr uint64_t mask_of(size_t idx) noexcept;
+    constexpr uint64_t valid_bits(size_t word_idx) const noexcept;
+    std::atomic_ref<uint64_t> word_ref(size_t word_idx) const noexcept;
+    size_t count_words(size_t first, size_t last) const noexcept;
+    uint64_t* ptr = nullptr;
+    size_t sz = 0;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "atomic_bits.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -1,43 +1,48 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
 #include "bit_reference.hpp"
+#undef IMPL_INCLUDES
+#endif
 #include <cstddef>
 #include <cstdint>
+#include <concepts>
 
-namespace {
-    static const size_t BITS_IN_BYTE = 8;
-
-    template <class Alloc>
-    using bit_reference = typename Vector<bool, Alloc>::reference;
-
-    uint8_t signed_rem(uint8_t val, int8_t sgn) {
-        return sgn > 0 ? BITS_IN_BYTE - val : val;
-    }
+template <class Alloc>
+constexpr Vector<bool, Alloc>::BitReference::BitReference(uint64_t* word, uint8_t bit) noexcept
+: word(word), bit(bit) {}
 
-    void signed_increment(uint8_t*& byte, uint8_t& bit, size_t idx, int8_t sgn) {
-        uint8_t rem = idx % BITS_IN_BYTE;
-        bool additional_byte = rem > signed_rem(bit, sgn);
-        byte += sgn * (idx / BITS_IN_BYTE + additional_byte);
-        bit = (bit + signed_rem(rem, sgn)) % BITS_IN_BYTE;
-    }
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::BitReference::operator=(bool val) noexcept -> BitReference& {
+    if (val)
+        *word |= uint64_t(1) << bit;
+    else
+        *word &= ~(uint64_t(1) << bit);
+    return *this;
 }
 
 template <class Alloc>
-constexpr Vector<bool, Alloc>::BitReference::BitReference(uint8_t* byte, uint8_t bit) noexcept
-: byte(byte), bit(bit) {}
+constexpr Vector<bool, Alloc>::BitReference::operator bool() const noexcept {
+    return (*word >> bit) & 1;
+}
 
 template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator=(bool val) noexcept -> BitReference& {
-    *byte += val << bit - *byte & (1 << bit);
+constexpr auto Vector<bool, Alloc>::BitReference::operator*() const noexcept -> BitReference {
     return *this;
 }
 
 template <class Alloc>
-constexpr Vector<bool, Alloc>::BitReference::operator bool() const noexcept {
-    return *byte & (1 << bit) >> bit;
+constexpr auto Vector<bool, Alloc>::BitReference::flip() noexcept -> void {
+    *word ^= uint64_t(1) << bit;
 }
 
 template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator+=(size_t idx) noexcept -> BitReference& {
-    signed_increment(byte, bit, idx, 1);
+constexpr auto Vector<bool, Alloc>::BitReference::operator+=(ptrdiff_t idx) noexcept -> BitReference& {
+    ptrdiff_t pos = bit + idx;
+    ptrdiff_t word_shift = pos >= 0
+        ? pos / static_cast<ptrdiff_t>(BITS_IN_WORD)
+        : -((-pos + BITS_IN_WORD - 1) / BITS_IN_WORD);
+    word += word_shift;
+    bit = pos - word_shift * static_cast<ptrdiff_t>(BITS_IN_WORD);
     return *this;
 }
 
@@ -54,9 +59,8 @@ constexpr auto Vector<bool, Alloc>::BitReference::operator++(int) noexcept -> Bi
 }
 
 template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator-=(size_t idx) noexcept -> BitReference& {
-    signed_increment(byte, bit, idx, -1);
-    return *this;
+constexpr auto Vector<bool, Alloc>::BitReference::operator-=(ptrdiff_t idx) noexcept -> BitReference& {
+    return *this += -idx;
 }
 
 template <class Alloc>
@@ -67,46 +71,33 @@ constexpr auto Vector<bool, Alloc>::BitReference::operator--() noexcept -> BitRe
 template <class Alloc>
 constexpr auto Vector<bool, Alloc>::BitReference::operator--(int) noexcept -> BitReference {
     BitReference copy = *this;
-    ++*this;
+    --*this;
     return copy;
 }
 
 template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator-(size_t idx) noexcept -> BitReference {
+template <std::integral I>
+constexpr auto Vector<bool, Alloc>::BitReference::operator+(I idx) const noexcept -> BitReference {
     BitReference copy = *this;
-    copy -= idx;
+    copy += idx;
     return copy;
 }
 
 template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator[](size_t idx) const noexcept -> bool {
-    return *this + idx;
-}
-
-template <class Alloc>
-constexpr auto Vector<bool, Alloc>::BitReference::operator[](size_t idx) noexcept -> BitReference {
-    return *this + idx;
-}
-
-template <class Alloc>
-constexpr auto operator+(const bit_reference<Alloc>& ref, size_t idx) noexcept 
--> bit_reference<Alloc> {
-    bit_reference<Alloc> copy = ref;
-    copy += idx;
+template <std::integral I>
+constexpr auto Vector<bool, Alloc>::BitReference::operator-(I idx) const noexcept -> BitReference {
+    BitReference copy = *this;
+    copy -= idx;
     return copy;
 }
 
 template <class Alloc>
-constexpr auto operator+(size_t idx, const bit_reference<Alloc>& ref) noexcept
--> bit_reference<Alloc> {
-    return ref + idx;
+constexpr auto Vector<bool, Alloc>::BitReference::operator-(const BitReference& other) const noexcept
+-> ptrdiff_t {
+    return (word - other.word) * static_cast<ptrdiff_t>(BITS_IN_WORD) + bit - other.bit;
 }
 
 template <class Alloc>
-constexpr auto operator-(
-    const bit_reference<Alloc>& lhs,
-    const bit_reference<Alloc>& rhs
-) noexcept -> ptrdiff_t {
-    return (static_cast<ptrdiff_t>(lhs.byte) - rhs.byte) * BITS_IN_BYTE
-    + lhs.bit - rhs.bit;
+constexpr auto Vector<bool, Alloc>::BitReference::operator[](ptrdiff_t idx) const noexcept -> BitReference {
+    return *this + idx;
 }
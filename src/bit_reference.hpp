@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <compare>
+#include <concepts>
 #include <iterator>
 #include "vector_bool.hpp"
 
@@ -15,40 +16,36 @@ public:
     using pointer = BitReference;
     using reference = BitReference;
     using iterator_category = std::random_access_iterator_tag;
-    constexpr BitReference(uint8_t* byte, uint8_t bit) noexcept;
+    constexpr BitReference() noexcept = default;
+    constexpr BitReference(uint64_t* word, uint8_t bit) noexcept;
     constexpr BitReference& operator=(bool val) noexcept;
     constexpr operator bool() const noexcept;
-    constexpr BitReference& operator+=(size_t idx) noexcept;
+    constexpr BitReference operator*() const noexcept;
+    constexpr void flip() noexcept;
+    constexpr BitReference& operator+=(ptrdiff_t idx) noexcept;
     constexpr BitReference& operator++() noexcept;
     constexpr BitReference operator++(int) noexcept;
-    constexpr BitReference& operator-=(size_t idx) noexcept;
+    constexpr BitReference& operator-=(ptrdiff_t idx) noexcept;
     constexpr BitReference& operator--() noexcept;
     constexpr BitReference operator--(int) noexcept;
-    constexpr BitReference operator-(size_t idx) noexcept;
-    constexpr bool operator[](size_t idx) const noexcept;
-    constexpr BitReference operator[](size_t idx) noexcept;
-    constexpr std::weak_ordering operator<=>(const BitReference& other) const noexcept = default;
+    template <std::integral I>
+    constexpr BitReference operator+(I idx) const noexcept;
+    template <std::integral I>
+    constexpr BitReference operator-(I idx) const noexcept;
+    constexpr ptrdiff_t operator-(const BitReference& other) const noexcept;
+    constexpr BitReference operator[](ptrdiff_t idx) const noexcept;
+    constexpr bool operator==(const BitReference& other) const noexcept = default;
+    constexpr std::strong_ordering operator<=>(const BitReference& other) const noexcept = default;
 private:
-    static const size_t BITS_IN_BYTE = 8;
-    uint8_t* byte;
-    uint8_t bit;
+    static const size_t BITS_IN_WORD = 64;
+    uint64_t* word = nullptr;
+    uint8_t bit = 0;
 };
 
-namespace {
-    template <class Alloc>
-    using bit_reference = typename Vector<bool, Alloc>::reference;
-}
-
-template <class Alloc>
-constexpr bit_reference<Alloc> operator+(const bit_reference<Alloc>& ref, size_t idx) noexcept;
-
-template <class Alloc>
-constexpr bit_reference<Alloc> operator+(size_t idx, const bit_reference<Alloc>& ref) noexcept;
-
-template <class Alloc>
-constexpr ptrdiff_t operator-(
-    const bit_reference<Alloc>& lhs, 
-    const bit_reference<Alloc>& rhs
-) noexcept;
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "bit_reference.cpp"
+#endif
+#undef HEADER_INCLUDES
 
 #endif
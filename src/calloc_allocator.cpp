@@ -0,0 +1,46 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "calloc_allocator.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+template <class T>
+template <class U>
+constexpr CallocAllocator<T>::CallocAllocator(const CallocAllocator<U>&) noexcept {}
+
+template <class T>
+auto CallocAllocator<T>::allocate(size_t cnt) -> T* {
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+    if (cnt > SIZE_MAX / sizeof(T))
+        throw std::bad_array_new_length();
+    void* res = std::malloc(cnt * sizeof(T));
+    if (res == nullptr && cnt != 0)
+        throw std::bad_alloc();
+    return static_cast<T*>(res);
+}
+
+template <class T>
+auto CallocAllocator<T>::allocate_zeroed(size_t cnt) -> T* {
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+    if (cnt > SIZE_MAX / sizeof(T))
+        throw std::bad_array_new_length();
+    void* res = std::calloc(cnt, sizeof(T));
+    if (res == nullptr && cnt != 0)
+        throw std::bad_alloc();
+    return static_cast<T*>(res);
+}
+
+template <class T>
+auto CallocAllocator<T>::deallocate(T* ptr, size_t) noexcept -> void {
+    std::free(ptr);
+}
+
+template <class T>
+template <class U>
+constexpr auto CallocAllocator<T>::operator==(const CallocAllocator<U>&) const noexcept -> bool {
+    return true;
+}
@@ -0,0 +1,27 @@
+#ifndef CALLOC_ALLOCATOR_H
+
+#define CALLOC_ALLOCATOR_H
+
+#include <cstddef>
+
+template <class T>
+class CallocAllocator {
+public:
+    using value_type = T;
+    constexpr CallocAllocator() noexcept = default;
+    template <class U>
+    constexpr CallocAllocator(const CallocAllocator<U>& other) noexcept;
+    T* allocate(size_t cnt);
+    T* allocate_zeroed(size_t cnt);
+    void deallocate(T* ptr, size_t cnt) noexcept;
+    template <class U>
+    constexpr bool operator==(const CallocAllocator<U>& other) const noexcept;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "calloc_allocator.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
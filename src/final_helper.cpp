@@ -4,6 +4,10 @@
 #undef IMPL_INCLUDES
 #endif
 
+template <class Alloc, bool Final>
+constexpr detail::FinalHelperImpl<Alloc, Final>::FinalHelperImpl(const Alloc& alloc) noexcept
+: Alloc(alloc) {}
+
 template <class Alloc>
 constexpr detail::FinalHelperImpl<Alloc, true>::FinalHelperImpl(const Alloc& alloc) noexcept
 : alloc(alloc) {}
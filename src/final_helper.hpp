@@ -6,7 +6,9 @@
 
 namespace detail {
 template <class Alloc, bool>
-struct FinalHelperImpl: Alloc {};
+struct FinalHelperImpl: Alloc {
+    constexpr FinalHelperImpl(const Alloc& alloc) noexcept;
+};
 
 template <class Alloc>
 struct FinalHelperImpl<Alloc, true> {
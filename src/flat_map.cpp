@@ -0,0 +1,228 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "flat_map.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+template <class K, class V, class Compare>
+constexpr FlatMap<K, V, Compare>::FlatMap(const Compare& comp)
+: comp(comp) {}
+
+template <class K, class V, class Compare>
+template <std::input_iterator InputIt>
+constexpr FlatMap<K, V, Compare>::FlatMap(InputIt first, InputIt last, const Compare& comp)
+: comp(comp) {
+    insert_bulk(first, last);
+}
+
+template <class K, class V, class Compare>
+constexpr FlatMap<K, V, Compare>::FlatMap(std::initializer_list<std::pair<K, V>> init, const Compare& comp)
+: FlatMap(init.begin(), init.end(), comp) {}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::size() const noexcept -> size_t {
+    return key_data.size();
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::empty() const noexcept -> bool {
+    return key_data.empty();
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::reserve(size_t new_cap) -> void {
+    key_data.reserve(new_cap);
+    value_data.reserve(new_cap);
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::clear() -> void {
+    key_data.clear();
+    value_data.clear();
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::keys() const noexcept -> const Vector<K>& {
+    return key_data;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::values() const noexcept -> const Vector<V>& {
+    return value_data;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::values() noexcept -> Vector<V>& {
+    return value_data;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::index_of(const K& key) const -> size_t {
+    const K* pos = detail::branchless_lower_bound(key_data.data(), key_data.size(), key, comp);
+    if (pos == key_data.end() || comp(key, *pos))
+        return key_data.size();
+    return pos - key_data.begin();
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::find(const K& key) const -> const V* {
+    size_t idx = index_of(key);
+    return idx == size() ? nullptr : value_data.data() + idx;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::find(const K& key) -> V* {
+    size_t idx = index_of(key);
+    return idx == size() ? nullptr : value_data.data() + idx;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::contains(const K& key) const -> bool {
+    return index_of(key) != size();
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::count(const K& key) const -> size_t {
+    return contains(key);
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::at(const K& key) const -> const V& {
+    const V* res = find(key);
+    if (res == nullptr)
+        throw std::out_of_range("FlatMap::at: key not found");
+    return *res;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::at(const K& key) -> V& {
+    V* res = find(key);
+    if (res == nullptr)
+        throw std::out_of_range("FlatMap::at: key not found");
+    return *res;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::operator[](const K& key) -> V& {
+    return *try_emplace(key).first;
+}
+
+template <class K, class V, class Compare>
+template <class... Args>
+constexpr auto FlatMap<K, V, Compare>::try_emplace(const K& key, Args&&... args) -> std::pair<V*, bool> {
+    const K* pos = detail::branchless_lower_bound(key_data.data(), key_data.size(), key, comp);
+    size_t idx = pos - key_data.begin();
+    if (pos != key_data.end() && !comp(key, *pos))
+        return {value_data.data() + idx, false};
+    value_data.emplace(value_data.begin() + idx, std::forward<Args>(args)...);
+    try {
+        key_data.insert(pos, key);
+    } catch(...) {
+        value_data.erase(value_data.begin() + idx);
+        throw;
+    }
+    return {value_data.data() + idx, true};
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::insert(const K& key, const V& val) -> std::pair<V*, bool> {
+    return try_emplace(key, val);
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::insert(const K& key, V&& val) -> std::pair<V*, bool> {
+    return try_emplace(key, std::move(val));
+}
+
+template <class K, class V, class Compare>
+template <class M>
+constexpr auto FlatMap<K, V, Compare>::insert_or_assign(const K& key, M&& val) -> std::pair<V*, bool> {
+    std::pair<V*, bool> res = try_emplace(key, std::forward<M>(val));
+    if (!res.second)
+        *res.first = std::forward<M>(val);
+    return res;
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::merge_tail(Vector<std::pair<K, V>>& tail) -> void {
+    std::pair<K, V>* tail_end = detail::sort_unique_new(
+        tail.begin(), tail.end(), key_data.data(), key_data.size(), comp,
+        [] (const std::pair<K, V>& elem) -> const K& { return elem.first; }
+    );
+    size_t old_sz = key_data.size();
+    size_t new_cnt = tail_end - tail.begin();
+    key_data.reserve(old_sz + new_cnt);
+    value_data.reserve(old_sz + new_cnt);
+    size_t i = old_sz;
+    size_t j = new_cnt;
+    for (size_t w = old_sz + new_cnt; w > old_sz; --w) {
+        if (i > 0 && comp(tail[j - 1].first, key_data[i - 1]))
+            --i;
+        else
+            --j;
+    }
+    for (size_t old_idx = i, new_idx = j; old_idx < old_sz || new_idx < new_cnt;) {
+        bool from_old = new_idx == new_cnt || (old_idx < old_sz && comp(key_data[old_idx], tail[new_idx].first));
+        K& key = from_old ? key_data[old_idx] : tail[new_idx].first;
+        V& val = from_old ? value_data[old_idx] : tail[new_idx].second;
+        ++(from_old ? old_idx : new_idx);
+        key_data.emplace_back(std::move(key));
+        try {
+            value_data.emplace_back(std::move(val));
+        } catch(...) {
+            key_data.pop_back();
+            throw;
+        }
+    }
+    size_t w = old_sz;
+    while (j > 0) {
+        --w;
+        if (i > 0 && comp(tail[j - 1].first, key_data[i - 1])) {
+            --i;
+            key_data[w] = std::move(key_data[i]);
+            value_data[w] = std::move(value_data[i]);
+        } else {
+            --j;
+            key_data[w] = std::move(tail[j].first);
+            value_data[w] = std::move(tail[j].second);
+        }
+    }
+}
+
+template <class K, class V, class Compare>
+template <std::input_iterator InputIt>
+constexpr auto FlatMap<K, V, Compare>::insert_bulk(InputIt first, InputIt last) -> void {
+    Vector<std::pair<K, V>> tail;
+    for (; first != last; ++first) {
+        auto&& elem = *first;
+        tail.emplace_back(std::get<0>(std::forward<decltype(elem)>(elem)), std::get<1>(std::forward<decltype(elem)>(elem)));
+    }
+    merge_tail(tail);
+}
+
+template <class K, class V, class Compare>
+template <std::ranges::input_range R>
+constexpr auto FlatMap<K, V, Compare>::insert_bulk(R&& range) -> void {
+    Vector<std::pair<K, V>> tail;
+    if constexpr (std::ranges::sized_range<R>)
+        tail.reserve(std::ranges::size(range));
+    for (auto&& elem : range)
+        tail.emplace_back(std::get<0>(std::forward<decltype(elem)>(elem)), std::get<1>(std::forward<decltype(elem)>(elem)));
+    merge_tail(tail);
+}
+
+template <class K, class V, class Compare>
+constexpr auto FlatMap<K, V, Compare>::erase(const K& key) -> size_t {
+    size_t idx = index_of(key);
+    if (idx == size())
+        return 0;
+    key_data.erase(key_data.begin() + idx);
+    value_data.erase(value_data.begin() + idx);
+    return 1;
+}
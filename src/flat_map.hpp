@@ -0,0 +1,65 @@
+#ifndef FLAT_MAP_H
+
+#define FLAT_MAP_H
+
+#include "flat_set.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+template <class K, class V, class Compare = std::less<K>>
+class FlatMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = size_t;
+    using key_compare = Compare;
+    constexpr FlatMap() = default;
+    explicit constexpr FlatMap(const Compare& comp);
+    template <std::input_iterator InputIt>
+    constexpr FlatMap(InputIt first, InputIt last, const Compare& comp = Compare());
+    constexpr FlatMap(std::initializer_list<std::pair<K, V>> init, const Compare& comp = Compare());
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr void reserve(size_t new_cap);
+    constexpr void clear();
+    constexpr const Vector<K>& keys() const noexcept;
+    constexpr const Vector<V>& values() const noexcept;
+    constexpr Vector<V>& values() noexcept;
+    constexpr size_t index_of(const K& key) const;
+    constexpr const V* find(const K& key) const;
+    constexpr V* find(const K& key);
+    constexpr bool contains(const K& key) const;
+    constexpr size_t count(const K& key) const;
+    constexpr const V& at(const K& key) const;
+    constexpr V& at(const K& key);
+    constexpr V& operator[](const K& key);
+    template <class... Args>
+    constexpr std::pair<V*, bool> try_emplace(const K& key, Args&&... args);
+    constexpr std::pair<V*, bool> insert(const K& key, const V& val);
+    constexpr std::pair<V*, bool> insert(const K& key, V&& val);
+    template <class M>
+    constexpr std::pair<V*, bool> insert_or_assign(const K& key, M&& val);
+    template <std::input_iterator InputIt>
+    constexpr void insert_bulk(InputIt first, InputIt last);
+    template <std::ranges::input_range R>
+    constexpr void insert_bulk(R&& range);
+    constexpr size_t erase(const K& key);
+private:
+    constexpr void merge_tail(Vector<std::pair<K, V>>& tail);
+    Vector<K> key_data;
+    Vector<V> value_data;
+    [[no_unique_address]] Compare comp;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "flat_map.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "flat_set.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+template <class K, class Compare>
+constexpr auto branchless_lower_bound(const K* first, size_t cnt, const K& key, const Compare& comp) -> const K* {
+    if (cnt == 0)
+        return first;
+    while (cnt > 1) {
+        size_t half = cnt / 2;
+        first = comp(first[half], key) ? first + half : first;
+        cnt -= half;
+    }
+    return first + comp(*first, key);
+}
+
+template <class T, class K, class Compare, class Proj>
+constexpr auto sort_unique_new(T* first, T* last, const K* keys, size_t key_cnt, const Compare& comp, Proj proj)
+-> T* {
+    auto less = [&] (const T& lhs, const T& rhs) {
+        return comp(proj(lhs), proj(rhs));
+    };
+    auto equivalent = [&] (const T& lhs, const T& rhs) {
+        return !less(lhs, rhs) && !less(rhs, lhs);
+    };
+    if (std::is_constant_evaluated()) {
+        for (T* it = first; it != last; ++it)
+            std::rotate(std::upper_bound(first, it, *it, less), it, it + 1);
+    } else {
+        std::stable_sort(first, last, less);
+    }
+    last = std::unique(first, last, equivalent);
+    return std::remove_if(first, last, [&] (const T& elem) {
+        const K* pos = branchless_lower_bound(keys, key_cnt, proj(elem), comp);
+        return pos != keys + key_cnt && !comp(proj(elem), *pos);
+    });
+}
+}
+
+template <class K, class Compare>
+constexpr FlatSet<K, Compare>::FlatSet(const Compare& comp)
+: comp(comp) {}
+
+template <class K, class Compare>
+template <std::input_iterator InputIt>
+constexpr FlatSet<K, Compare>::FlatSet(InputIt first, InputIt last, const Compare& comp)
+: comp(comp) {
+    insert_bulk(first, last);
+}
+
+template <class K, class Compare>
+constexpr FlatSet<K, Compare>::FlatSet(std::initializer_list<K> init, const Compare& comp)
+: FlatSet(init.begin(), init.end(), comp) {}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::size() const noexcept -> size_t {
+    return data.size();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::empty() const noexcept -> bool {
+    return data.empty();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::reserve(size_t new_cap) -> void {
+    data.reserve(new_cap);
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::clear() -> void {
+    data.clear();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::keys() const noexcept -> const Vector<K>& {
+    return data;
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::begin() const noexcept -> const K* {
+    return data.begin();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::end() const noexcept -> const K* {
+    return data.end();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::lower_bound(const K& key) const -> const K* {
+    return detail::branchless_lower_bound(data.data(), data.size(), key, comp);
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::find(const K& key) const -> const K* {
+    const K* pos = lower_bound(key);
+    return pos != end() && !comp(key, *pos) ? pos : end();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::contains(const K& key) const -> bool {
+    return find(key) != end();
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::count(const K& key) const -> size_t {
+    return contains(key);
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::insert(const K& key) -> std::pair<const K*, bool> {
+    return insert(K(key));
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::insert(K&& key) -> std::pair<const K*, bool> {
+    const K* pos = lower_bound(key);
+    if (pos != end() && !comp(key, *pos))
+        return {pos, false};
+    return {data.insert(pos, std::move(key)), true};
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::merge_tail(size_t old_sz) -> void {
+    K* mid = data.begin() + old_sz;
+    K* new_end = detail::sort_unique_new(mid, data.end(), data.data(), old_sz, comp, std::identity());
+    data.erase(new_end, data.end());
+    Vector<K> tail(std::make_move_iterator(mid), std::make_move_iterator(data.end()));
+    size_t i = old_sz;
+    size_t j = tail.size();
+    size_t w = data.size();
+    while (j > 0) {
+        --w;
+        if (i > 0 && comp(tail[j - 1], data[i - 1])) {
+            --i;
+            data[w] = std::move(data[i]);
+        } else {
+            --j;
+            data[w] = std::move(tail[j]);
+        }
+    }
+}
+
+template <class K, class Compare>
+template <std::input_iterator InputIt>
+constexpr auto FlatSet<K, Compare>::insert_bulk(InputIt first, InputIt last) -> void {
+    size_t old_sz = data.size();
+    for (; first != last; ++first)
+        data.emplace_back(*first);
+    merge_tail(old_sz);
+}
+
+template <class K, class Compare>
+template <std::ranges::input_range R>
+constexpr auto FlatSet<K, Compare>::insert_bulk(R&& range) -> void {
+    size_t old_sz = data.size();
+    if constexpr (std::ranges::sized_range<R>)
+        data.reserve(old_sz + std::ranges::size(range));
+    for (auto&& key : range)
+        data.emplace_back(std::forward<decltype(key)>(key));
+    merge_tail(old_sz);
+}
+
+template <class K, class Compare>
+constexpr auto FlatSet<K, Compare>::erase(const K& key) -> size_t {
+    const K* pos = find(key);
+    if (pos == end())
+        return 0;
+    data.erase(pos);
+    return 1;
+}
@@ -0,0 +1,65 @@
+#ifndef FLAT_SET_H
+
+#define FLAT_SET_H
+
+#include "vector.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace detail {
+template <class K, class Compare>
+constexpr const K* branchless_lower_bound(const K* first, size_t cnt, const K& key, const Compare& comp);
+
+template <class T, class K, class Compare, class Proj>
+constexpr T* sort_unique_new(T* first, T* last, const K* keys, size_t key_cnt, const Compare& comp, Proj proj);
+}
+
+template <class K, class Compare = std::less<K>>
+class FlatSet {
+public:
+    using key_type = K;
+    using value_type = K;
+    using size_type = size_t;
+    using key_compare = Compare;
+    using iterator = const K*;
+    using const_iterator = const K*;
+    constexpr FlatSet() = default;
+    explicit constexpr FlatSet(const Compare& comp);
+    template <std::input_iterator InputIt>
+    constexpr FlatSet(InputIt first, InputIt last, const Compare& comp = Compare());
+    constexpr FlatSet(std::initializer_list<K> init, const Compare& comp = Compare());
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr void reserve(size_t new_cap);
+    constexpr void clear();
+    constexpr const Vector<K>& keys() const noexcept;
+    constexpr const K* begin() const noexcept;
+    constexpr const K* end() const noexcept;
+    constexpr const K* lower_bound(const K& key) const;
+    constexpr const K* find(const K& key) const;
+    constexpr bool contains(const K& key) const;
+    constexpr size_t count(const K& key) const;
+    constexpr std::pair<const K*, bool> insert(const K& key);
+    constexpr std::pair<const K*, bool> insert(K&& key);
+    template <std::input_iterator InputIt>
+    constexpr void insert_bulk(InputIt first, InputIt last);
+    template <std::ranges::input_range R>
+    constexpr void insert_bulk(R&& range);
+    constexpr size_t erase(const K& key);
+private:
+    constexpr void merge_tail(size_t old_sz);
+    Vector<K> data;
+    [[no_unique_address]] Compare comp;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "flat_set.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,563 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "gap_vector.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::GapVector(const Alloc& alloc) noexcept
+: alloc(alloc) {}
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::GapVector(size_t sz, const T& val, const Alloc& alloc)
+: GapVector(alloc) {
+    if (sz == 0)
+        return;
+    ptr = AllocTraits::allocate(this->alloc, sz);
+    try {
+        detail::uninitialized_fill(this->alloc, ptr, sz, val);
+    } catch(...) {
+        AllocTraits::deallocate(this->alloc, ptr, sz);
+        ptr = nullptr;
+        throw;
+    }
+    cap = sz;
+    gap_begin = sz;
+    gap_end = sz;
+}
+
+template <class T, class Alloc>
+template <std::input_iterator InputIt>
+constexpr GapVector<T, Alloc>::GapVector(InputIt first, InputIt last, const Alloc& alloc)
+: GapVector(alloc) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        size_t sz = std::distance(first, last);
+        if (sz == 0)
+            return;
+        ptr = AllocTraits::allocate(this->alloc, sz);
+        try {
+            detail::uninitialized_copy(this->alloc, first, sz, ptr);
+        } catch(...) {
+            AllocTraits::deallocate(this->alloc, ptr, sz);
+            ptr = nullptr;
+            throw;
+        }
+        cap = sz;
+        gap_begin = sz;
+        gap_end = sz;
+    } else {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+}
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::GapVector(std::initializer_list<T> init, const Alloc& alloc)
+: GapVector(init.begin(), init.end(), alloc) {}
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::GapVector(const GapVector& other)
+: GapVector(detail::copy_allocator(other.alloc)) {
+    copy_segments(other);
+}
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::GapVector(GapVector&& other) noexcept
+: alloc(std::move(other.alloc)), ptr(std::exchange(other.ptr, nullptr)), cap(std::exchange(other.cap, 0)),
+  gap_begin(std::exchange(other.gap_begin, 0)), gap_end(std::exchange(other.gap_end, 0)) {}
+
+template <class T, class Alloc>
+constexpr GapVector<T, Alloc>::~GapVector() {
+    detail::destroy(alloc, ptr, ptr + gap_begin);
+    detail::destroy(alloc, ptr + gap_end, ptr + cap);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, cap);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::operator=(const GapVector& other) & -> GapVector& {
+    constexpr bool propagate = typename AllocTraits::propagate_on_container_copy_assignment();
+    GapVector copy(propagate ? other.alloc : alloc);
+    copy.copy_segments(other);
+    swap(copy);
+    return *this;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::operator=(GapVector&& other) & -> GapVector& {
+    constexpr bool propagate = typename AllocTraits::propagate_on_container_move_assignment();
+    if constexpr (propagate || AllocTraits::is_always_equal::value) {
+        GapVector copy(std::move(other));
+        if constexpr (!propagate)
+            copy.alloc = alloc;
+        std::swap(ptr, copy.ptr);
+        std::swap(cap, copy.cap);
+        std::swap(gap_begin, copy.gap_begin);
+        std::swap(gap_end, copy.gap_end);
+        std::swap(alloc, copy.alloc);
+    } else {
+        GapVector copy(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), alloc);
+        swap(copy);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::swap(GapVector& other) & noexcept -> void {
+    constexpr bool propagate = typename AllocTraits::propagate_on_container_swap();
+    if constexpr (propagate)
+        std::swap(alloc, other.alloc);
+    std::swap(ptr, other.ptr);
+    std::swap(cap, other.cap);
+    std::swap(gap_begin, other.gap_begin);
+    std::swap(gap_end, other.gap_end);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::get_allocator() const noexcept -> Alloc {
+    return alloc;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::size() const noexcept -> size_t {
+    return cap - gap_size();
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::empty() const noexcept -> bool {
+    return size() == 0;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::capacity() const noexcept -> size_t {
+    return cap;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::gap_position() const noexcept -> size_t {
+    return gap_begin;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::operator[](size_t idx) noexcept -> T& {
+    return ptr[idx < gap_begin ? idx : idx + gap_size()];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::operator[](size_t idx) const noexcept -> const T& {
+    return ptr[idx < gap_begin ? idx : idx + gap_size()];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::at(size_t idx) -> T& {
+    if (idx >= size())
+        detail::throw_out_of_range(idx, size());
+    return (*this)[idx];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::at(size_t idx) const -> const T& {
+    if (idx >= size())
+        detail::throw_out_of_range(idx, size());
+    return (*this)[idx];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::front() noexcept -> T& {
+    return (*this)[0];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::front() const noexcept -> const T& {
+    return (*this)[0];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::back() noexcept -> T& {
+    return (*this)[size() - 1];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::back() const noexcept -> const T& {
+    return (*this)[size() - 1];
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::move_gap(size_t pos) -> void {
+    size_t gap = gap_size();
+    if (pos < gap_begin)
+        shift(ptr + pos, ptr + gap_begin, ptr + pos + gap);
+    else if (pos > gap_begin)
+        shift(ptr + gap_end, ptr + pos + gap, ptr + gap_begin);
+    gap_begin = pos;
+    gap_end = pos + gap;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::contiguous() -> std::span<T> {
+    move_gap(size());
+    return {ptr, gap_begin};
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::reserve(size_t new_cap) -> void {
+    if (new_cap > cap)
+        reallocate(new_cap);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::clear() noexcept -> void {
+    detail::destroy(alloc, ptr, ptr + gap_begin);
+    detail::destroy(alloc, ptr + gap_end, ptr + cap);
+    gap_begin = 0;
+    gap_end = cap;
+}
+
+template <class T, class Alloc>
+template <class... Args>
+constexpr auto GapVector<T, Alloc>::emplace(size_t pos, Args&&... args) -> iterator {
+    if (pos == gap_begin && gap_begin != gap_end) {
+        AllocTraits::construct(alloc, ptr + gap_begin, std::forward<Args>(args)...);
+    } else {
+        T val(std::forward<Args>(args)...);
+        open_gap(pos, 1);
+        AllocTraits::construct(alloc, ptr + gap_begin, std::move(val));
+    }
+    ++gap_begin;
+    return iterator(this, pos);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::insert(size_t pos, const T& val) -> iterator {
+    return emplace(pos, val);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::insert(size_t pos, T&& val) -> iterator {
+    return emplace(pos, std::move(val));
+}
+
+template <class T, class Alloc>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto GapVector<T, Alloc>::insert_range(size_t pos, R&& range) -> iterator {
+    if constexpr (std::ranges::forward_range<R>) {
+        open_gap(pos, std::ranges::distance(range));
+        for (auto&& val : range) {
+            AllocTraits::construct(alloc, ptr + gap_begin, std::forward<decltype(val)>(val));
+            ++gap_begin;
+        }
+    } else {
+        size_t idx = pos;
+        for (auto&& val : range)
+            emplace(idx++, std::forward<decltype(val)>(val));
+    }
+    return iterator(this, pos);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::erase(size_t pos) -> iterator {
+    return erase(pos, pos + 1);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::erase(size_t first, size_t last) -> iterator {
+    move_gap(first);
+    detail::destroy(alloc, ptr + gap_end, ptr + gap_end + (last - first));
+    gap_end += last - first;
+    return iterator(this, first);
+}
+
+template <class T, class Alloc>
+template <class... Args>
+constexpr auto GapVector<T, Alloc>::emplace_back(Args&&... args) -> T& {
+    return *emplace(size(), std::forward<Args>(args)...);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::push_back(const T& val) -> void {
+    emplace(size(), val);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::push_back(T&& val) -> void {
+    emplace(size(), std::move(val));
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::pop_back() -> void {
+    erase(size() - 1);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::begin() noexcept -> iterator {
+    return iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::begin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::cbegin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::end() noexcept -> iterator {
+    return iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::end() const noexcept -> const_iterator {
+    return const_iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::cend() const noexcept -> const_iterator {
+    return const_iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::rbegin() noexcept -> reverse_iterator {
+    return reverse_iterator(end());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::rbegin() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(end());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::rend() noexcept -> reverse_iterator {
+    return reverse_iterator(begin());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::rend() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(begin());
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::gap_size() const noexcept -> size_t {
+    return gap_end - gap_begin;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::shift(T* first, T* last, T* dest) noexcept -> void {
+    static_assert(std::is_nothrow_move_constructible_v<T>);
+    if (first == dest)
+        return;
+    if constexpr (std::is_trivially_copyable_v<T> && !detail::AllocatorConstructs<Alloc, T, T&&>) {
+        if (!std::is_constant_evaluated()) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+            return;
+        }
+    }
+    if (dest < first) {
+        for (; first != last; ++first, ++dest) {
+            AllocTraits::construct(alloc, dest, std::move(*first));
+            AllocTraits::destroy(alloc, first);
+        }
+    } else {
+        dest += last - first;
+        while (last != first) {
+            --last;
+            --dest;
+            AllocTraits::construct(alloc, dest, std::move(*last));
+            AllocTraits::destroy(alloc, last);
+        }
+    }
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::copy_segments(const GapVector& other) -> void {
+    size_t sz = other.size();
+    if (sz == 0)
+        return;
+    ptr = AllocTraits::allocate(alloc, sz);
+    try {
+        detail::uninitialized_copy(alloc, other.ptr, other.gap_begin, ptr);
+    } catch(...) {
+        AllocTraits::deallocate(alloc, ptr, sz);
+        ptr = nullptr;
+        throw;
+    }
+    try {
+        detail::uninitialized_copy(alloc, other.ptr + other.gap_end, other.cap - other.gap_end, ptr + other.gap_begin);
+    } catch(...) {
+        detail::destroy_before(alloc, ptr, sz, other.gap_begin);
+        ptr = nullptr;
+        throw;
+    }
+    cap = sz;
+    gap_begin = sz;
+    gap_end = sz;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::reallocate(size_t new_cap) -> void {
+    static_assert(std::is_nothrow_move_constructible_v<T>);
+    T* buf = AllocTraits::allocate(alloc, new_cap);
+    size_t tail = cap - gap_end;
+    detail::uninitialized_relocate(alloc, ptr, ptr + gap_begin, buf);
+    detail::uninitialized_relocate(alloc, ptr + gap_end, ptr + cap, buf + new_cap - tail);
+    detail::destroy(alloc, ptr, ptr + gap_begin);
+    detail::destroy(alloc, ptr + gap_end, ptr + cap);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, cap);
+    ptr = buf;
+    cap = new_cap;
+    gap_end = new_cap - tail;
+}
+
+template <class T, class Alloc>
+constexpr auto GapVector<T, Alloc>::open_gap(size_t pos, size_t cnt) -> void {
+    move_gap(pos);
+    if (gap_size() >= cnt)
+        return;
+    size_t new_cap = cap ? cap : INITIAL_CAP;
+    while (size() + cnt > new_cap)
+        new_cap *= GROWTH_RATE;
+    reallocate(new_cap);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr GapVector<T, Alloc>::GapIterator<Const>::GapIterator(Owner* owner, size_t idx) noexcept
+: owner(owner), idx(idx) {}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr GapVector<T, Alloc>::GapIterator<Const>::operator GapIterator<true>() const noexcept {
+    return GapIterator<true>(owner, idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::index() const noexcept -> size_t {
+    return idx;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator*() const noexcept -> reference {
+    return (*owner)[idx];
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator->() const noexcept -> pointer {
+    return &(*owner)[idx];
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator[](difference_type idx) const noexcept
+-> reference {
+    return (*owner)[this->idx + idx];
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator+=(difference_type idx) noexcept
+-> GapIterator& {
+    this->idx += idx;
+    return *this;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator-=(difference_type idx) noexcept
+-> GapIterator& {
+    this->idx -= idx;
+    return *this;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator++() noexcept -> GapIterator& {
+    return *this += 1;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator++(int) noexcept -> GapIterator {
+    GapIterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator--() noexcept -> GapIterator& {
+    return *this -= 1;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator--(int) noexcept -> GapIterator {
+    GapIterator copy = *this;
+    --*this;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator+(difference_type idx) const noexcept
+-> GapIterator {
+    GapIterator copy = *this;
+    copy += idx;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator-(difference_type idx) const noexcept
+-> GapIterator {
+    GapIterator copy = *this;
+    copy -= idx;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator-(const GapIterator& other) const noexcept
+-> difference_type {
+    return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator==(const GapIterator& other) const noexcept
+-> bool {
+    return idx == other.idx;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto GapVector<T, Alloc>::GapIterator<Const>::operator<=>(const GapIterator& other) const noexcept
+-> std::strong_ordering {
+    return idx <=> other.idx;
+}
+
+template <class T, class Alloc>
+constexpr auto operator==(const GapVector<T, Alloc>& lhs, const GapVector<T, Alloc>& rhs) -> bool {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+namespace std {
+    template <class T, class Alloc>
+    constexpr auto swap(GapVector<T, Alloc>& lhs, GapVector<T, Alloc>& rhs) noexcept -> void {
+        lhs.swap(rhs);
+    }
+}
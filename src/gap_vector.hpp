@@ -0,0 +1,149 @@
+#ifndef GAP_VECTOR_H
+
+#define GAP_VECTOR_H
+
+#include "vector.hpp"
+#include <cstddef>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+template <class T, class Alloc = std::allocator<T>>
+class GapVector {
+private:
+    template <bool Const>
+    class GapIterator;
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = GapIterator<false>;
+    using const_iterator = GapIterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    constexpr GapVector() noexcept(noexcept(Alloc())) = default;
+    explicit constexpr GapVector(const Alloc& alloc) noexcept;
+    constexpr GapVector(size_t sz, const T& val, const Alloc& alloc = Alloc());
+    template <std::input_iterator InputIt>
+    constexpr GapVector(InputIt first, InputIt last, const Alloc& alloc = Alloc());
+    constexpr GapVector(std::initializer_list<T> init, const Alloc& alloc = Alloc());
+    constexpr GapVector(const GapVector& other);
+    constexpr GapVector(GapVector&& other) noexcept;
+    constexpr ~GapVector();
+    constexpr GapVector& operator=(const GapVector& other) &;
+    constexpr GapVector& operator=(GapVector&& other) &;
+    constexpr void swap(GapVector& other) & noexcept;
+    constexpr Alloc get_allocator() const noexcept;
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr size_t capacity() const noexcept;
+    constexpr size_t gap_position() const noexcept;
+    constexpr T& operator[](size_t idx) noexcept;
+    constexpr const T& operator[](size_t idx) const noexcept;
+    constexpr T& at(size_t idx);
+    constexpr const T& at(size_t idx) const;
+    constexpr T& front() noexcept;
+    constexpr const T& front() const noexcept;
+    constexpr T& back() noexcept;
+    constexpr const T& back() const noexcept;
+    constexpr void move_gap(size_t pos);
+    constexpr std::span<T> contiguous();
+    constexpr void reserve(size_t new_cap);
+    constexpr void clear() noexcept;
+    template <class... Args>
+    constexpr iterator emplace(size_t pos, Args&&... args);
+    constexpr iterator insert(size_t pos, const T& val);
+    constexpr iterator insert(size_t pos, T&& val);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr iterator insert_range(size_t pos, R&& range);
+    constexpr iterator erase(size_t pos);
+    constexpr iterator erase(size_t first, size_t last);
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args);
+    constexpr void push_back(const T& val);
+    constexpr void push_back(T&& val);
+    constexpr void pop_back();
+    constexpr iterator begin() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+    constexpr reverse_iterator rbegin() noexcept;
+    constexpr const_reverse_iterator rbegin() const noexcept;
+    constexpr reverse_iterator rend() noexcept;
+    constexpr const_reverse_iterator rend() const noexcept;
+private:
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static const size_t INITIAL_CAP = 16;
+    static const size_t GROWTH_RATE = 2;
+    constexpr size_t gap_size() const noexcept;
+    constexpr void shift(T* first, T* last, T* dest) noexcept;
+    constexpr void copy_segments(const GapVector& other);
+    constexpr void reallocate(size_t new_cap);
+    constexpr void open_gap(size_t pos, size_t cnt);
+    [[no_unique_address]] Alloc alloc;
+    T* ptr = nullptr;
+    size_t cap = 0;
+    size_t gap_begin = 0;
+    size_t gap_end = 0;
+};
+
+template <class T, class Alloc>
+template <bool Const>
+class GapVector<T, Alloc>::GapIterator {
+public:
+    using difference_type = ptrdiff_t;
+    using value_type = T;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using iterator_category = std::random_access_iterator_tag;
+    using Owner = std::conditional_t<Const, const GapVector, GapVector>;
+    constexpr GapIterator() noexcept = default;
+    constexpr GapIterator(Owner* owner, size_t idx) noexcept;
+    constexpr operator GapIterator<true>() const noexcept;
+    constexpr size_t index() const noexcept;
+    constexpr reference operator*() const noexcept;
+    constexpr pointer operator->() const noexcept;
+    constexpr reference operator[](difference_type idx) const noexcept;
+    constexpr GapIterator& operator+=(difference_type idx) noexcept;
+    constexpr GapIterator& operator-=(difference_type idx) noexcept;
+    constexpr GapIterator& operator++() noexcept;
+    constexpr GapIterator operator++(int) noexcept;
+    constexpr GapIterator& operator--() noexcept;
+    constexpr GapIterator operator--(int) noexcept;
+    constexpr GapIterator operator+(difference_type idx) const noexcept;
+    constexpr GapIterator operator-(difference_type idx) const noexcept;
+    constexpr difference_type operator-(const GapIterator& other) const noexcept;
+    constexpr bool operator==(const GapIterator& other) const noexcept;
+    constexpr std::strong_ordering operator<=>(const GapIterator& other) const noexcept;
+    friend constexpr GapIterator operator+(difference_type idx, const GapIterator& it) noexcept {
+        return it + idx;
+    }
+private:
+    Owner* owner = nullptr;
+    size_t idx = 0;
+};
+
+template <class T, class Alloc>
+constexpr bool operator==(const GapVector<T, Alloc>& lhs, const GapVector<T, Alloc>& rhs);
+
+namespace std {
+    template <class T, class Alloc>
+    constexpr void swap(GapVector<T, Alloc>& lhs, GapVector<T, Alloc>& rhs) noexcept;
+}
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "gap_vector.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,450 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "inplace_vector.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <class T, size_t N>
+constexpr detail::InplaceStorage<T, N, false>::InplaceStorage() noexcept {}
+
+template <class T, size_t N>
+constexpr detail::InplaceStorage<T, N, false>::InplaceStorage(const InplaceStorage& other) {
+    try {
+        for (; sz < other.sz; ++sz)
+            std::construct_at(elems + sz, other.elems[sz]);
+    } catch(...) {
+        std::destroy(elems, elems + sz);
+        throw;
+    }
+}
+
+template <class T, size_t N>
+constexpr detail::InplaceStorage<T, N, false>::InplaceStorage(InplaceStorage&& other)
+noexcept(std::is_nothrow_move_constructible_v<T>) {
+    try {
+        for (; sz < other.sz; ++sz)
+            std::construct_at(elems + sz, std::move(other.elems[sz]));
+    } catch(...) {
+        std::destroy(elems, elems + sz);
+        throw;
+    }
+}
+
+template <class T, size_t N>
+constexpr auto detail::InplaceStorage<T, N, false>::operator=(const InplaceStorage& other) -> InplaceStorage& {
+    if (this == &other)
+        return *this;
+    size_t common = std::min(sz, other.sz);
+    std::copy(other.elems, other.elems + common, elems);
+    std::destroy(elems + common, elems + sz);
+    for (sz = common; sz < other.sz; ++sz)
+        std::construct_at(elems + sz, other.elems[sz]);
+    return *this;
+}
+
+template <class T, size_t N>
+constexpr auto detail::InplaceStorage<T, N, false>::operator=(InplaceStorage&& other)
+noexcept(std::is_nothrow_move_assignable_v<T>) -> InplaceStorage& {
+    if (this == &other)
+        return *this;
+    size_t common = std::min(sz, other.sz);
+    std::move(other.elems, other.elems + common, elems);
+    std::destroy(elems + common, elems + sz);
+    for (sz = common; sz < other.sz; ++sz)
+        std::construct_at(elems + sz, std::move(other.elems[sz]));
+    return *this;
+}
+
+template <class T, size_t N>
+constexpr detail::InplaceStorage<T, N, false>::~InplaceStorage() {
+    std::destroy(elems, elems + sz);
+}
+
+template <class T, size_t N>
+constexpr InplaceVector<T, N>::InplaceVector(size_t sz) {
+    resize(sz);
+}
+
+template <class T, size_t N>
+constexpr InplaceVector<T, N>::InplaceVector(size_t sz, const T& val) {
+    resize(sz, val);
+}
+
+template <class T, size_t N>
+template <std::input_iterator InputIt>
+constexpr InplaceVector<T, N>::InplaceVector(InputIt first, InputIt last) {
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <class T, size_t N>
+constexpr InplaceVector<T, N>::InplaceVector(std::initializer_list<T> init)
+: InplaceVector(init.begin(), init.end()) {}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::swap(InplaceVector& other) & noexcept(std::is_nothrow_swappable_v<T>)
+-> void {
+    InplaceVector& longer = sz < other.sz ? other : *this;
+    InplaceVector& shorter = sz < other.sz ? *this : other;
+    size_t common = shorter.sz;
+    std::swap_ranges(elems, elems + common, other.elems);
+    for (size_t i = common; i < longer.sz; ++i)
+        shorter.unchecked_emplace_back(std::move(longer.elems[i]));
+    longer.erase(longer.begin() + common, longer.end());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::size() const noexcept -> size_t {
+    return sz;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::empty() const noexcept -> bool {
+    return sz == 0;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::capacity() noexcept -> size_t {
+    return N;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::max_size() noexcept -> size_t {
+    return N;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::front() const noexcept -> const T& {
+    return elems[0];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::front() noexcept -> T& {
+    return elems[0];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::back() const noexcept -> const T& {
+    return elems[sz - 1];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::back() noexcept -> T& {
+    return elems[sz - 1];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::data() const noexcept -> const T* {
+    return elems;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::data() noexcept -> T* {
+    return elems;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::operator[](size_t idx) const noexcept -> const T& {
+    return elems[idx];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::operator[](size_t idx) noexcept -> T& {
+    return elems[idx];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::at(size_t idx) const -> const T& {
+    if (idx >= sz)
+        detail::throw_out_of_range(idx, sz);
+    return elems[idx];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::at(size_t idx) -> T& {
+    if (idx >= sz)
+        detail::throw_out_of_range(idx, sz);
+    return elems[idx];
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::assign(size_t new_sz, const T& val) -> void {
+    reserve(new_sz);
+    clear();
+    resize(new_sz, val);
+}
+
+template <class T, size_t N>
+template <std::input_iterator InputIt>
+constexpr auto InplaceVector<T, N>::assign(InputIt first, InputIt last) -> void {
+    clear();
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::assign(std::initializer_list<T> init) -> void {
+    assign(init.begin(), init.end());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::reserve(size_t new_cap) -> void {
+    if (new_cap > N)
+        throw std::bad_alloc();
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::shrink_to_fit() noexcept -> void {}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::resize(size_t new_sz, const T& val) -> void {
+    reserve(new_sz);
+    if (new_sz <= sz) {
+        erase(cbegin() + new_sz, cend());
+        return;
+    }
+    while (sz < new_sz)
+        unchecked_emplace_back(val);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::resize(size_t new_sz) -> void {
+    reserve(new_sz);
+    if (new_sz <= sz) {
+        erase(cbegin() + new_sz, cend());
+        return;
+    }
+    while (sz < new_sz)
+        unchecked_emplace_back();
+}
+
+template <class T, size_t N>
+template <class... Args>
+constexpr auto InplaceVector<T, N>::emplace(const T* pos, Args&&... args) -> T* {
+    T* res = elems + (pos - elems);
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(res, end() - 1, end());
+    return res;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::insert(const T* pos, const T& val) -> T* {
+    return emplace(pos, val);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::insert(const T* pos, T&& val) -> T* {
+    return emplace(pos, std::move(val));
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::insert(const T* pos, size_t new_sz, const T& val) -> T* {
+    T* res = elems + (pos - elems);
+    reserve(sz + new_sz);
+    T* old_end = end();
+    for (size_t i = 0; i < new_sz; ++i)
+        unchecked_emplace_back(val);
+    std::rotate(res, old_end, end());
+    return res;
+}
+
+template <class T, size_t N>
+template <std::input_iterator InputIt>
+constexpr auto InplaceVector<T, N>::insert(const T* pos, InputIt first, InputIt last) -> T* {
+    T* res = elems + (pos - elems);
+    T* old_end = end();
+    for (; first != last; ++first)
+        emplace_back(*first);
+    std::rotate(res, old_end, end());
+    return res;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::insert(const T* pos, std::initializer_list<T> init) -> T* {
+    return insert(pos, init.begin(), init.end());
+}
+
+template <class T, size_t N>
+template <class... Args>
+constexpr auto InplaceVector<T, N>::emplace_back(Args&&... args) -> T& {
+    if (sz == N)
+        throw std::bad_alloc();
+    return unchecked_emplace_back(std::forward<Args>(args)...);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::push_back(const T& val) -> void {
+    emplace_back(val);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::push_back(T&& val) -> void {
+    emplace_back(std::move(val));
+}
+
+template <class T, size_t N>
+template <class... Args>
+constexpr auto InplaceVector<T, N>::try_emplace_back(Args&&... args) -> T* {
+    if (sz == N)
+        return nullptr;
+    return &unchecked_emplace_back(std::forward<Args>(args)...);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::try_push_back(const T& val) -> T* {
+    return try_emplace_back(val);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::try_push_back(T&& val) -> T* {
+    return try_emplace_back(std::move(val));
+}
+
+template <class T, size_t N>
+template <class... Args>
+constexpr auto InplaceVector<T, N>::unchecked_emplace_back(Args&&... args) -> T& {
+    T* res = std::construct_at(elems + sz, std::forward<Args>(args)...);
+    ++sz;
+    return *res;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::unchecked_push_back(const T& val) -> T& {
+    return unchecked_emplace_back(val);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::unchecked_push_back(T&& val) -> T& {
+    return unchecked_emplace_back(std::move(val));
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::erase(const T* pos) -> T* {
+    return erase(pos, pos + 1);
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::erase(const T* first, const T* last) -> T* {
+    T* res = elems + (first - elems);
+    T* new_end = std::move(res + (last - first), end(), res);
+    std::destroy(new_end, end());
+    sz = new_end - elems;
+    return res;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::pop_back() -> void {
+    std::destroy_at(elems + sz - 1);
+    --sz;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::clear() noexcept -> void {
+    std::destroy(elems, elems + sz);
+    sz = 0;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::begin() const noexcept -> const T* {
+    return elems;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::begin() noexcept -> T* {
+    return elems;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::cbegin() const noexcept -> const T* {
+    return elems;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::rbegin() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(end());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::rbegin() noexcept -> reverse_iterator {
+    return reverse_iterator(end());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::crbegin() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(end());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::end() const noexcept -> const T* {
+    return elems + sz;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::end() noexcept -> T* {
+    return elems + sz;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::cend() const noexcept -> const T* {
+    return elems + sz;
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::rend() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(begin());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::rend() noexcept -> reverse_iterator {
+    return reverse_iterator(begin());
+}
+
+template <class T, size_t N>
+constexpr auto InplaceVector<T, N>::crend() const noexcept -> const_reverse_iterator {
+    return const_reverse_iterator(begin());
+}
+
+template <class T, size_t N>
+constexpr auto operator==(const InplaceVector<T, N>& lhs, const InplaceVector<T, N>& rhs) -> bool {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+constexpr auto operator<=>(const InplaceVector<T, N>& lhs, const InplaceVector<T, N>& rhs)
+-> std::weak_ordering {
+    return std::lexicographical_compare_three_way(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        [] (const T& a, const T& b) { return std::compare_weak_order_fallback(a, b); }
+    );
+}
+
+template <class T, size_t N, class Pred>
+constexpr auto erase_if(InplaceVector<T, N>& vec, Pred pred) -> size_t {
+    T* res = std::remove_if(vec.begin(), vec.end(), pred);
+    size_t cnt = vec.end() - res;
+    vec.erase(res, vec.end());
+    return cnt;
+}
+
+template <class T, size_t N, class U>
+constexpr auto erase(InplaceVector<T, N>& vec, const U& val) -> size_t {
+    return erase_if(vec, [&val] (const T& elem) -> bool {
+        return elem == val;
+    });
+}
+
+namespace std {
+    template <class T, size_t N>
+    constexpr auto swap(InplaceVector<T, N>& lhs, InplaceVector<T, N>& rhs) -> void {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef INPLACE_VECTOR_H
+
+#define INPLACE_VECTOR_H
+
+#include "util.hpp"
+#include <cstddef>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+namespace detail {
+template <class T, size_t N>
+constexpr bool TRIVIAL_INPLACE_STORAGE =
+    std::is_trivially_copyable_v<T> &&
+    std::is_trivially_default_constructible_v<T> &&
+    std::is_trivially_destructible_v<T>;
+
+template <class T, size_t N, bool = TRIVIAL_INPLACE_STORAGE<T, N>>
+struct InplaceStorage {
+    T elems[N ? N : 1];
+    size_t sz = 0;
+};
+
+template <class T, size_t N>
+struct InplaceStorage<T, N, false> {
+    constexpr InplaceStorage() noexcept;
+    constexpr InplaceStorage(const InplaceStorage& other);
+    constexpr InplaceStorage(InplaceStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    constexpr InplaceStorage& operator=(const InplaceStorage& other);
+    constexpr InplaceStorage& operator=(InplaceStorage&& other) noexcept(std::is_nothrow_move_assignable_v<T>);
+    constexpr ~InplaceStorage();
+    union {
+        T elems[N ? N : 1];
+    };
+    size_t sz = 0;
+};
+}
+
+template <class T, size_t N>
+class InplaceVector: private detail::InplaceStorage<T, N> {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    constexpr InplaceVector() noexcept = default;
+    explicit constexpr InplaceVector(size_t sz);
+    constexpr InplaceVector(size_t sz, const T& val);
+    template <std::input_iterator InputIt>
+    constexpr InplaceVector(InputIt first, InputIt last);
+    constexpr InplaceVector(std::initializer_list<T> init);
+    constexpr void swap(InplaceVector& other) & noexcept(std::is_nothrow_swappable_v<T>);
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    static constexpr size_t capacity() noexcept;
+    static constexpr size_t max_size() noexcept;
+    constexpr const T& front() const noexcept;
+    constexpr T& front() noexcept;
+    constexpr const T& back() const noexcept;
+    constexpr T& back() noexcept;
+    constexpr const T* data() const noexcept;
+    constexpr T* data() noexcept;
+    constexpr const T& operator[](size_t idx) const noexcept;
+    constexpr T& operator[](size_t idx) noexcept;
+    constexpr const T& at(size_t idx) const;
+    constexpr T& at(size_t idx);
+    constexpr void assign(size_t new_sz, const T& val);
+    template <std::input_iterator InputIt>
+    constexpr void assign(InputIt first, InputIt last);
+    constexpr void assign(std::initializer_list<T> init);
+    static constexpr void reserve(size_t new_cap);
+    static constexpr void shrink_to_fit() noexcept;
+    constexpr void resize(size_t new_sz, const T& val);
+    constexpr void resize(size_t new_sz);
+    template <class... Args>
+    constexpr T* emplace(const T* pos, Args&&... args);
+    constexpr T* insert(const T* pos, const T& val);
+    constexpr T* insert(const T* pos, T&& val);
+    constexpr T* insert(const T* pos, size_t new_sz, const T& val);
+    template <std::input_iterator InputIt>
+    constexpr T* insert(const T* pos, InputIt first, InputIt last);
+    constexpr T* insert(const T* pos, std::initializer_list<T> init);
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args);
+    constexpr void push_back(const T& val);
+    constexpr void push_back(T&& val);
+    template <class... Args>
+    constexpr T* try_emplace_back(Args&&... args);
+    constexpr T* try_push_back(const T& val);
+    constexpr T* try_push_back(T&& val);
+    template <class... Args>
+    constexpr T& unchecked_emplace_back(Args&&... args);
+    constexpr T& unchecked_push_back(const T& val);
+    constexpr T& unchecked_push_back(T&& val);
+    constexpr T* erase(const T* pos);
+    constexpr T* erase(const T* first, const T* last);
+    constexpr void pop_back();
+    constexpr void clear() noexcept;
+    constexpr const T* begin() const noexcept;
+    constexpr T* begin() noexcept;
+    constexpr const T* cbegin() const noexcept;
+    constexpr const_reverse_iterator rbegin() const noexcept;
+    constexpr reverse_iterator rbegin() noexcept;
+    constexpr const_reverse_iterator crbegin() const noexcept;
+    constexpr const T* end() const noexcept;
+    constexpr T* end() noexcept;
+    constexpr const T* cend() const noexcept;
+    constexpr const_reverse_iterator rend() const noexcept;
+    constexpr reverse_iterator rend() noexcept;
+    constexpr const_reverse_iterator crend() const noexcept;
+private:
+    using Storage = detail::InplaceStorage<T, N>;
+    using Storage::elems;
+    using Storage::sz;
+};
+
+template <class T, size_t N>
+constexpr bool operator==(const InplaceVector<T, N>& lhs, const InplaceVector<T, N>& rhs);
+
+template <class T, size_t N>
+constexpr std::weak_ordering operator<=>(const InplaceVector<T, N>& lhs, const InplaceVector<T, N>& rhs);
+
+template <class T, size_t N, class U = T>
+constexpr size_t erase(InplaceVector<T, N>& vec, const U& val);
+
+template <class T, size_t N, class Pred>
+constexpr size_t erase_if(InplaceVector<T, N>& vec, Pred pred);
+
+namespace std {
+    template <class T, size_t N>
+    constexpr void swap(InplaceVector<T, N>& lhs, InplaceVector<T, N>& rhs);
+}
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "inplace_vector.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "jagged_vector.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <class T, class Alloc>
+constexpr JaggedVector<T, Alloc>::JaggedVector(const Alloc& alloc) noexcept
+: value_data(alloc), offset_data(OffsetAlloc(alloc)) {}
+
+template <class T, class Alloc>
+constexpr JaggedVector<T, Alloc>::JaggedVector(std::initializer_list<std::initializer_list<T>> init, const Alloc& alloc)
+: JaggedVector(alloc) {
+    size_t value_cnt = 0;
+    for (const auto& row : init)
+        value_cnt += row.size();
+    reserve(init.size(), value_cnt);
+    for (const auto& row : init)
+        push_row(row);
+}
+
+template <class T, class Alloc>
+template <std::ranges::random_access_range R>
+requires std::ranges::sized_range<R>
+constexpr auto JaggedVector<T, Alloc>::from_pairs(size_t row_cnt, R&& pairs, const Alloc& alloc) -> JaggedVector {
+    JaggedVector res(alloc);
+    if (row_cnt == 0)
+        return res;
+    size_t cnt = std::ranges::size(pairs);
+    auto first = std::ranges::begin(pairs);
+    res.offset_data.assign(row_cnt + 1, 0);
+    for (size_t i = 0; i < cnt; ++i) {
+        size_t row = static_cast<size_t>(std::get<0>(first[i]));
+        if (row >= row_cnt)
+            detail::throw_out_of_range(row, row_cnt);
+        ++res.offset_data[row + 1];
+    }
+    std::partial_sum(res.offset_data.begin(), res.offset_data.end(), res.offset_data.begin());
+    Vector<size_t, OffsetAlloc> cursor(res.offset_data.begin(), res.offset_data.end() - 1, OffsetAlloc(alloc));
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+        res.value_data.resize(cnt);
+        for (size_t i = 0; i < cnt; ++i)
+            res.value_data[cursor[static_cast<size_t>(std::get<0>(first[i]))]++] = std::get<1>(first[i]);
+    } else {
+        Vector<size_t, OffsetAlloc> order(cnt, OffsetAlloc(alloc));
+        for (size_t i = 0; i < cnt; ++i)
+            order[cursor[static_cast<size_t>(std::get<0>(first[i]))]++] = i;
+        res.value_data.reserve(cnt);
+        for (size_t idx : order)
+            res.value_data.emplace_back(std::get<1>(first[idx]));
+    }
+    return res;
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::get_allocator() const noexcept -> Alloc {
+    return value_data.get_allocator();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::size() const noexcept -> size_t {
+    return offset_data.empty() ? 0 : offset_data.size() - 1;
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::empty() const noexcept -> bool {
+    return offset_data.empty();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::value_count() const noexcept -> size_t {
+    return value_data.size();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::row_size(size_t idx) const noexcept -> size_t {
+    return offset_data[idx + 1] - offset_data[idx];
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::operator[](size_t idx) noexcept -> row_type {
+    return row(idx);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::operator[](size_t idx) const noexcept -> const_row_type {
+    return row(idx);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::row(size_t idx) noexcept -> row_type {
+    return {value_data.data() + offset_data[idx], row_size(idx)};
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::row(size_t idx) const noexcept -> const_row_type {
+    return {value_data.data() + offset_data[idx], row_size(idx)};
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::at(size_t idx) -> row_type {
+    if (idx >= size())
+        detail::throw_out_of_range(idx, size());
+    return row(idx);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::at(size_t idx) const -> const_row_type {
+    if (idx >= size())
+        detail::throw_out_of_range(idx, size());
+    return row(idx);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::back() noexcept -> row_type {
+    return row(size() - 1);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::back() const noexcept -> const_row_type {
+    return row(size() - 1);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::values() noexcept -> std::span<T> {
+    return {value_data.data(), value_data.size()};
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::values() const noexcept -> std::span<const T> {
+    return {value_data.data(), value_data.size()};
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::offsets() const noexcept -> std::span<const size_t> {
+    return {offset_data.data(), offset_data.size()};
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::reserve(size_t row_cap, size_t value_cap) -> void {
+    offset_data.reserve(row_cap + 1);
+    value_data.reserve(value_cap);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::shrink_to_fit() -> void {
+    offset_data.shrink_to_fit();
+    value_data.shrink_to_fit();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::clear() -> void {
+    offset_data.clear();
+    value_data.clear();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::push_row() -> row_type {
+    return push_row(std::span<const T>());
+}
+
+template <class T, class Alloc>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto JaggedVector<T, Alloc>::push_row(R&& range) -> row_type {
+    open_row();
+    size_t old_cnt = value_data.size();
+    try {
+        value_data.append_range(std::forward<R>(range));
+        offset_data.push_back(value_data.size());
+    } catch (...) {
+        rollback(old_cnt);
+        throw;
+    }
+    return back();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::push_row(std::initializer_list<T> init) -> row_type {
+    return push_row(std::span<const T>(init.begin(), init.size()));
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::pop_row() -> void {
+    value_data.erase(value_data.begin() + offset_data[offset_data.size() - 2], value_data.end());
+    offset_data.pop_back();
+    if (offset_data.size() == 1)
+        offset_data.clear();
+}
+
+template <class T, class Alloc>
+template <class... Args>
+constexpr auto JaggedVector<T, Alloc>::emplace_last(Args&&... args) -> T& {
+    T& res = value_data.emplace_back(std::forward<Args>(args)...);
+    ++offset_data.back();
+    return res;
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::push_last(const T& val) -> void {
+    emplace_last(val);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::push_last(T&& val) -> void {
+    emplace_last(std::move(val));
+}
+
+template <class T, class Alloc>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto JaggedVector<T, Alloc>::append_last(R&& range) -> void {
+    size_t old_cnt = value_data.size();
+    try {
+        value_data.append_range(std::forward<R>(range));
+    } catch (...) {
+        rollback(old_cnt);
+        throw;
+    }
+    offset_data.back() = value_data.size();
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::swap(JaggedVector& other) noexcept -> void {
+    value_data.swap(other.value_data);
+    offset_data.swap(other.offset_data);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::begin() noexcept -> iterator {
+    return iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::begin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::cbegin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::end() noexcept -> iterator {
+    return iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::end() const noexcept -> const_iterator {
+    return const_iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::cend() const noexcept -> const_iterator {
+    return const_iterator(this, size());
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::open_row() -> void {
+    if (offset_data.empty())
+        offset_data.push_back(0);
+}
+
+template <class T, class Alloc>
+constexpr auto JaggedVector<T, Alloc>::rollback(size_t old_cnt) -> void {
+    value_data.erase(value_data.begin() + old_cnt, value_data.end());
+    if (offset_data.size() == 1)
+        offset_data.clear();
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr JaggedVector<T, Alloc>::RowIterator<Const>::RowIterator(Owner* owner, size_t idx) noexcept
+: owner(owner), idx(idx) {}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr JaggedVector<T, Alloc>::RowIterator<Const>::operator RowIterator<true>() const noexcept {
+    return RowIterator<true>(owner, idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator*() const noexcept -> reference {
+    return owner->row(idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator[](difference_type idx) const noexcept
+-> reference {
+    return owner->row(this->idx + idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator+=(difference_type idx) noexcept
+-> RowIterator& {
+    this->idx += idx;
+    return *this;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator-=(difference_type idx) noexcept
+-> RowIterator& {
+    this->idx -= idx;
+    return *this;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator++() noexcept -> RowIterator& {
+    return *this += 1;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator++(int) noexcept -> RowIterator {
+    RowIterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator--() noexcept -> RowIterator& {
+    return *this -= 1;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator--(int) noexcept -> RowIterator {
+    RowIterator copy = *this;
+    --*this;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator+(difference_type idx) const noexcept
+-> RowIterator {
+    RowIterator copy = *this;
+    copy += idx;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator-(difference_type idx) const noexcept
+-> RowIterator {
+    RowIterator copy = *this;
+    copy -= idx;
+    return copy;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator-(const RowIterator& other) const noexcept
+-> difference_type {
+    return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx);
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator==(const RowIterator& other) const noexcept
+-> bool {
+    return idx == other.idx;
+}
+
+template <class T, class Alloc>
+template <bool Const>
+constexpr auto JaggedVector<T, Alloc>::RowIterator<Const>::operator<=>(const RowIterator& other) const noexcept
+-> std::strong_ordering {
+    return idx <=> other.idx;
+}
+
+template <class T, class Alloc>
+constexpr auto operator==(const JaggedVector<T, Alloc>& lhs, const JaggedVector<T, Alloc>& rhs) -> bool {
+    return std::ranges::equal(lhs.offsets(), rhs.offsets()) && std::ranges::equal(lhs.values(), rhs.values());
+}
+
+namespace std {
+    template <class T, class Alloc>
+    constexpr auto swap(JaggedVector<T, Alloc>& lhs, JaggedVector<T, Alloc>& rhs) noexcept -> void {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef JAGGED_VECTOR_H
+
+#define JAGGED_VECTOR_H
+
+#include "vector.hpp"
+#include <cstddef>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+template <class T, class Alloc = std::allocator<T>>
+class JaggedVector {
+private:
+    template <bool Const>
+    class RowIterator;
+    using OffsetAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_t>;
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using row_type = std::span<T>;
+    using const_row_type = std::span<const T>;
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+    constexpr JaggedVector() noexcept(noexcept(Alloc())) = default;
+    explicit constexpr JaggedVector(const Alloc& alloc) noexcept;
+    constexpr JaggedVector(std::initializer_list<std::initializer_list<T>> init, const Alloc& alloc = Alloc());
+    template <std::ranges::random_access_range R>
+    requires std::ranges::sized_range<R>
+    static constexpr JaggedVector from_pairs(size_t row_cnt, R&& pairs, const Alloc& alloc = Alloc());
+    constexpr Alloc get_allocator() const noexcept;
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr size_t value_count() const noexcept;
+    constexpr size_t row_size(size_t idx) const noexcept;
+    constexpr row_type operator[](size_t idx) noexcept;
+    constexpr const_row_type operator[](size_t idx) const noexcept;
+    constexpr row_type row(size_t idx) noexcept;
+    constexpr const_row_type row(size_t idx) const noexcept;
+    constexpr row_type at(size_t idx);
+    constexpr const_row_type at(size_t idx) const;
+    constexpr row_type back() noexcept;
+    constexpr const_row_type back() const noexcept;
+    constexpr std::span<T> values() noexcept;
+    constexpr std::span<const T> values() const noexcept;
+    constexpr std::span<const size_t> offsets() const noexcept;
+    constexpr void reserve(size_t row_cap, size_t value_cap);
+    constexpr void shrink_to_fit();
+    constexpr void clear();
+    constexpr row_type push_row();
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr row_type push_row(R&& range);
+    constexpr row_type push_row(std::initializer_list<T> init);
+    constexpr void pop_row();
+    template <class... Args>
+    constexpr T& emplace_last(Args&&... args);
+    constexpr void push_last(const T& val);
+    constexpr void push_last(T&& val);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr void append_last(R&& range);
+    constexpr void swap(JaggedVector& other) noexcept;
+    constexpr iterator begin() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+private:
+    constexpr void open_row();
+    constexpr void rollback(size_t old_cnt);
+    Vector<T, Alloc> value_data;
+    Vector<size_t, OffsetAlloc> offset_data;
+};
+
+template <class T, class Alloc>
+template <bool Const>
+class JaggedVector<T, Alloc>::RowIterator {
+public:
+    using difference_type = ptrdiff_t;
+    using value_type = std::conditional_t<Const, std::span<const T>, std::span<T>>;
+    using reference = value_type;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+    using Owner = std::conditional_t<Const, const JaggedVector, JaggedVector>;
+    constexpr RowIterator() noexcept = default;
+    constexpr RowIterator(Owner* owner, size_t idx) noexcept;
+    constexpr operator RowIterator<true>() const noexcept;
+    constexpr reference operator*() const noexcept;
+    constexpr reference operator[](difference_type idx) const noexcept;
+    constexpr RowIterator& operator+=(difference_type idx) noexcept;
+    constexpr RowIterator& operator-=(difference_type idx) noexcept;
+    constexpr RowIterator& operator++() noexcept;
+    constexpr RowIterator operator++(int) noexcept;
+    constexpr RowIterator& operator--() noexcept;
+    constexpr RowIterator operator--(int) noexcept;
+    constexpr RowIterator operator+(difference_type idx) const noexcept;
+    constexpr RowIterator operator-(difference_type idx) const noexcept;
+    constexpr difference_type operator-(const RowIterator& other) const noexcept;
+    constexpr bool operator==(const RowIterator& other) const noexcept;
+    constexpr std::strong_ordering operator<=>(const RowIterator& other) const noexcept;
+    friend constexpr RowIterator operator+(difference_type idx, const RowIterator& it) noexcept {
+        return it + idx;
+    }
+private:
+    Owner* owner = nullptr;
+    size_t idx = 0;
+};
+
+template <class T, class Alloc>
+constexpr bool operator==(const JaggedVector<T, Alloc>& lhs, const JaggedVector<T, Alloc>& rhs);
+
+namespace std {
+    template <class T, class Alloc>
+    constexpr void swap(JaggedVector<T, Alloc>& lhs, JaggedVector<T, Alloc>& rhs) noexcept;
+}
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "jagged_vector.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
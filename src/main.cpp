@@ -1,6 +1,854 @@
+#include "atomic_bits.hpp"
+#include "calloc_allocator.hpp"
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "gap_vector.hpp"
+#include "inplace_vector.hpp"
+#include "jagged_vector.hpp"
+#include "numa_allocator.hpp"
+#include "parallel.hpp"
+#include "pool_allocator.hpp"
+#include "shrink_allocator.hpp"
+#include "soa_vector.hpp"
+#include "thread_pool.hpp"
 #include "vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace {
+    constexpr bool push_back_grows() {
+        Vector<int> vec;
+        for (int i = 0; i < 100; ++i)
+            vec.push_back(i);
+        return vec.size() == 100 && vec.front() == 0 && vec.back() == 99 && vec.capacity() >= 100;
+    }
+
+    constexpr bool insert_shifts() {
+        Vector<int> vec{1, 2, 5};
+        vec.insert(vec.begin() + 2, {3, 4});
+        vec.insert(vec.begin(), 0);
+        vec.insert(vec.end(), 2, 6);
+        return vec == Vector<int>{0, 1, 2, 3, 4, 5, 6, 6};
+    }
+
+    template <bool SIZED>
+    class InputInts {
+    public:
+        class iterator {
+        public:
+            using value_type = int;
+            using difference_type = ptrdiff_t;
+
+            constexpr iterator(const int* pos, const int* last) : pos(pos), last(last) {}
+            constexpr int operator*() const { return *pos; }
+            constexpr iterator& operator++() { ++pos; return *this; }
+            constexpr void operator++(int) { ++pos; }
+            constexpr bool operator==(std::default_sentinel_t) const { return pos == last; }
+        private:
+            const int* pos;
+            const int* last;
+        };
+
+        constexpr InputInts(const int* first, const int* last) : first(first), last(last) {}
+        constexpr iterator begin() const { return {first, last}; }
+        constexpr std::default_sentinel_t end() const { return {}; }
+        constexpr size_t size() const requires SIZED { return last - first; }
+    private:
+        const int* first;
+        const int* last;
+    };
+
+    static_assert(std::ranges::input_range<InputInts<false>> && !std::ranges::forward_range<InputInts<false>>);
+    static_assert(!std::ranges::sized_range<InputInts<false>> && std::ranges::sized_range<InputInts<true>>);
+
+    constexpr bool from_range_builds() {
+        const int vals[] = {1, 2, 3, 4, 5};
+        Vector<int> input(from_range, InputInts<false>(vals, vals + 5));
+        Vector<int> sized(from_range, InputInts<true>(vals, vals + 5));
+        Vector<int> forward(from_range, std::span<const int>(vals));
+        return input == Vector<int>{1, 2, 3, 4, 5} && sized == input && forward == input && sized.capacity() == 5
+            && forward.capacity() == 5;
+    }
+
+    constexpr bool append_range_extends() {
+        const int vals[] = {4, 5, 6};
+        Vector<int> vec{1, 2, 3};
+        vec.append_range(InputInts<false>(vals, vals + 3));
+        vec.append_range(InputInts<true>(vals, vals + 2));
+        vec.append_range(std::span<const int>(vals, 1));
+        vec.append_range(Vector<int>());
+        return vec == Vector<int>{1, 2, 3, 4, 5, 6, 4, 5, 4};
+    }
+
+    constexpr bool insert_range_in_middle() {
+        const int vals[] = {7, 8, 9};
+        Vector<int> grown{1, 2, 3, 4};
+        size_t cap = grown.capacity();
+        int* pos = grown.insert_range(grown.begin() + 1, std::span<const int>(vals));
+        bool forward_grown = grown == Vector<int>{1, 7, 8, 9, 2, 3, 4} && grown.capacity() > cap
+            && pos == grown.begin() + 1;
+        Vector<int> in_place{1, 2, 3, 4};
+        in_place.reserve(16);
+        cap = in_place.capacity();
+        in_place.insert_range(in_place.begin() + 3, std::span<const int>(vals));
+        pos = in_place.insert_range(in_place.begin() + 1, std::span<const int>(vals, 1));
+        bool forward_in_place = in_place == Vector<int>{1, 7, 2, 3, 7, 8, 9, 4} && in_place.capacity() == cap
+            && pos == in_place.begin() + 1;
+        Vector<int> input_grown{1, 2, 3, 4};
+        cap = input_grown.capacity();
+        pos = input_grown.insert_range(input_grown.begin() + 2, InputInts<false>(vals, vals + 3));
+        bool input_reallocated = input_grown == Vector<int>{1, 2, 7, 8, 9, 3, 4} && input_grown.capacity() > cap
+            && pos == input_grown.begin() + 2;
+        Vector<int> sized_in_place{1, 2, 3, 4};
+        sized_in_place.reserve(16);
+        cap = sized_in_place.capacity();
+        sized_in_place.insert_range(sized_in_place.begin(), InputInts<true>(vals, vals + 2));
+        bool sized_kept = sized_in_place == Vector<int>{7, 8, 1, 2, 3, 4} && sized_in_place.capacity() == cap;
+        return forward_grown && forward_in_place && input_reallocated && sized_kept;
+    }
+
+    constexpr bool assign_range_replaces() {
+        const int vals[] = {5, 6, 7, 8, 9, 10};
+        Vector<int> vec{1, 2, 3};
+        vec.assign_range(std::span<const int>(vals));
+        bool grown = vec == Vector<int>{5, 6, 7, 8, 9, 10};
+        vec.assign_range(InputInts<false>(vals, vals + 2));
+        bool shrunk = vec == Vector<int>{5, 6};
+        vec.assign_range(InputInts<true>(vals + 3, vals + 6));
+        return grown && shrunk && vec == Vector<int>{8, 9, 10};
+    }
+
+    constexpr bool erase_compacts() {
+        Vector<int> vec{0, 1, 2, 3, 4, 5, 6, 7};
+        vec.erase(vec.begin() + 1);
+        vec.erase(vec.begin() + 2, vec.begin() + 4);
+        vec.pop_back();
+        return vec == Vector<int>{0, 2, 5, 6} && erase_if(vec, [] (int x) { return x % 2 == 0; }) == 3;
+    }
+
+    constexpr bool sort_orders() {
+        Vector<int> vec{5, 3, 9, 1, 7};
+        std::sort(vec.begin(), vec.end());
+        Vector<int> copy = vec;
+        return copy == Vector<int>{1, 3, 5, 7, 9} && (copy <=> vec) == 0;
+    }
+
+    constexpr bool nested_vectors() {
+        Vector<Vector<int>> rows;
+        for (int i = 0; i < 8; ++i)
+            rows.emplace_back(static_cast<size_t>(i), i);
+        rows.erase(rows.begin());
+        rows.resize(10);
+        return rows[0].size() == 1 && rows[6][6] == 7 && rows[9].empty();
+    }
+
+    constexpr bool inplace_fills_to_capacity() {
+        InplaceVector<int, 4> vec{3, 1};
+        vec.insert(vec.begin() + 1, 2);
+        vec.unchecked_push_back(0);
+        bool full = vec.try_push_back(5) == nullptr;
+        std::sort(vec.begin(), vec.end());
+        vec.erase(vec.begin());
+        return full && vec == InplaceVector<int, 4>{1, 2, 3};
+    }
+
+    constexpr bool inplace_holds_vectors() {
+        InplaceVector<Vector<int>, 3> rows;
+        rows.emplace_back(2u, 7);
+        rows.try_emplace_back(3u, 8);
+        InplaceVector<Vector<int>, 3> copy = rows;
+        copy.erase(copy.begin());
+        copy.swap(rows);
+        return rows.size() == 1 && copy.size() == 2 && rows[0][2] == 8;
+    }
+
+    constexpr bool flat_map_keeps_order() {
+        FlatMap<int, int> map;
+        for (int key : {5, 1, 4, 1, 3})
+            map[key] += key;
+        map.insert_or_assign(4, 40);
+        map.erase(3);
+        return map.keys() == Vector<int>{1, 4, 5} && map.values() == Vector<int>{2, 40, 5} && map.find(3) == nullptr;
+    }
+
+    struct Label {
+        int val;
+
+        constexpr explicit Label(int val) : val(val) {}
+    };
+
+    constexpr bool flat_map_merges_bulk() {
+        FlatMap<int, Label> map;
+        map.insert_bulk(Vector<std::pair<int, Label>>{{30, Label(3)}, {10, Label(1)}});
+        map.insert_bulk(Vector<std::pair<int, Label>>{
+            {35, Label(35)}, {5, Label(5)}, {10, Label(0)}, {20, Label(2)}, {5, Label(0)}, {50, Label(50)}
+        });
+        map.insert_bulk(Vector<std::pair<int, Label>>{{60, Label(60)}, {70, Label(70)}});
+        return map.keys() == Vector<int>{5, 10, 20, 30, 35, 50, 60, 70} && map.find(5)->val == 5
+            && map.find(10)->val == 1 && map.find(20)->val == 2 && map.find(30)->val == 3 && map.find(35)->val == 35
+            && map.find(70)->val == 70;
+    }
+
+    struct Token {
+        int val;
+
+        constexpr explicit Token(int val) : val(val) {}
+        Token(const Token&) = delete;
+        Token(Token&&) = default;
+        Token& operator=(Token&&) = default;
+    };
+
+    constexpr bool flat_map_moves_bulk() {
+        Vector<std::pair<int, Token>> src;
+        src.emplace_back(20, Token(20));
+        src.emplace_back(10, Token(10));
+        FlatMap<int, Token> map;
+        map.insert_bulk(std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+        src.clear();
+        src.emplace_back(15, Token(15));
+        src.emplace_back(10, Token(0));
+        map.insert_bulk(std::ranges::subrange(std::make_move_iterator(src.begin()), std::make_move_iterator(src.end())));
+        return map.keys() == Vector<int>{10, 15, 20} && map.find(10)->val == 10 && map.find(15)->val == 15;
+    }
+
+    constexpr bool flat_set_merges_bulk() {
+        FlatSet<int> set{3, 1, 2, 3};
+        bool ok = set.keys() == Vector<int>{1, 2, 3};
+        set.insert_bulk(Vector<int>{5, 2, 0, 4, 0});
+        set.insert(6);
+        set.erase(1);
+        int tail[] = {9, 7, 8};
+        set.insert_bulk(std::begin(tail), std::end(tail));
+        return ok && set.keys() == Vector<int>{0, 2, 3, 4, 5, 6, 7, 8, 9} && set.contains(4) && !set.contains(1)
+            && set.count(2) == 1 && *set.lower_bound(1) == 2 && set.find(10) == set.end();
+    }
+
+    constexpr bool bool_words_pack_bits() {
+        Vector<bool> bits{true, false, true};
+        bits.push_back(true);
+        bits.flip();
+        bits.resize(70, true);
+        bits.pop_back();
+        return bits.words().size() == 2 && bits.words()[0] == (~uint64_t(0) << 4 | 0b0010)
+            && bits.words()[1] == 0x1F && bits.count() == 66;
+    }
+
+    constexpr bool bool_assigns_own_words() {
+        Vector<bool> bits(70, true);
+        Vector<bool> copy = bits;
+        bool grown = copy.capacity() == 70;
+        copy.assign(copy.words(), 128);
+        bits.assign(bits.words().subspan(1), 6);
+        return grown && copy.size() == 128 && copy.count() == 70 && bits.size() == 6 && bits.count() == 6;
+    }
+
+    constexpr bool shrink_keeps_reserve() {
+        Vector<int, ShrinkAllocator<int>> vec;
+        vec.reserve(8192);
+        size_t cap = vec.capacity();
+        for (int i = 0; i < 8192; ++i)
+            vec.push_back(i);
+        bool kept = vec.capacity() == cap;
+        while (vec.size() > 8)
+            vec.pop_back();
+        return kept && vec.capacity() < cap && vec.back() == 7;
+    }
+
+    constexpr bool erase_indices_compacts() {
+        Vector<int> vec{0, 1, 2, 3, 4, 5, 6};
+        size_t none = vec.erase_indices(Vector<size_t>{});
+        size_t cnt = vec.erase_indices(Vector<size_t>{0, 2, 2, 6});
+        return none == 0 && cnt == 3 && vec == Vector<int>{1, 3, 4, 5};
+    }
+
+    constexpr bool erase_mask_by_words() {
+        Vector<int> vec;
+        Vector<int> kept;
+        Vector<bool> mask;
+        for (int i = 0; i < 150; ++i) {
+            bool erased = i < 64 ? i % 3 == 0 : i < 128 || i % 2 == 0;
+            vec.push_back(i);
+            mask.push_back(erased);
+            if (!erased)
+                kept.push_back(i);
+        }
+        size_t none = vec.erase_mask(Vector<bool>());
+        size_t cnt = vec.erase_mask(mask);
+        bool mixed = none == 0 && cnt == 150 - kept.size() && vec == kept;
+        size_t all = vec.erase_mask(Vector<bool>(vec.size(), true));
+        return mixed && all == kept.size() && vec.empty();
+    }
+
+    constexpr bool jagged_rows_share_storage() {
+        JaggedVector<int> rows{{1, 2}, {}};
+        rows.push_last(3);
+        rows.push_row(Vector<int>{4, 5});
+        rows.emplace_last(6);
+        auto built = JaggedVector<int>::from_pairs(3, Vector<std::pair<int, int>>{{2, 4}, {0, 1}, {1, 3}, {2, 5}, {0, 2}, {2, 6}});
+        return rows == built && rows.row_size(1) == 1 && rows.values().size() == 6 && rows.offsets()[2] == 3;
+    }
+
+    constexpr bool gap_edits_at_cursor() {
+        GapVector<Vector<int>> lines{{1}, {2}, {3}};
+        lines.insert(1, Vector<int>{4});
+        lines.erase(2);
+        lines.emplace(1, 2u, 5);
+        lines.move_gap(0);
+        auto text = lines.contiguous();
+        return text.size() == 4 && text[0][0] == 1 && text[1] == Vector<int>{5, 5} && text[2][0] == 4 && text[3][0] == 3;
+    }
+
+    constexpr bool compact_keeps_api() {
+        CompactVector<int> vec{4, 1, 3};
+        vec.insert(vec.begin() + 1, 2);
+        std::sort(vec.begin(), vec.end());
+        vec.erase(vec.begin());
+        return vec == CompactVector<int>{2, 3, 4} && vec.max_size() == UINT32_MAX;
+    }
+
+    constexpr Vector<uint32_t> crc32_table() {
+        Vector<uint32_t> table;
+        table.reserve(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            table.push_back(crc);
+        }
+        return table;
+    }
+
+    static_assert(push_back_grows());
+    static_assert(insert_shifts());
+    static_assert(from_range_builds());
+    static_assert(append_range_extends());
+    static_assert(insert_range_in_middle());
+    static_assert(assign_range_replaces());
+    static_assert(erase_compacts());
+    static_assert(sort_orders());
+    static_assert(nested_vectors());
+    static_assert(inplace_fills_to_capacity());
+    static_assert(inplace_holds_vectors());
+    static_assert(flat_map_keeps_order());
+    static_assert(flat_map_merges_bulk());
+    static_assert(flat_map_moves_bulk());
+    static_assert(flat_set_merges_bulk());
+    static_assert(FlatSet<int>{3, 1, 2}.keys() == Vector<int>{1, 2, 3});
+    static_assert(bool_words_pack_bits());
+    static_assert(bool_assigns_own_words());
+    static_assert(shrink_keeps_reserve());
+    static_assert(erase_indices_compacts());
+    static_assert(erase_mask_by_words());
+    static_assert(jagged_rows_share_storage());
+    static_assert(gap_edits_at_cursor());
+    static_assert(compact_keeps_api());
+    static_assert(sizeof(Vector<int>) == 3 * sizeof(void*));
+    static_assert(sizeof(CompactVector<int>) == 16);
+    static_assert(PoolAllocator<int>::good_size(5) == 12 && pool::size_class(pool::class_bytes(3) - pool::HEADER_SIZE) == 3);
+    static_assert(std::is_trivially_copyable_v<InplaceVector<int, 16>>);
+
+    constexpr auto CRC32_TABLE = freeze<crc32_table>();
+    static_assert(CRC32_TABLE.size() == 256 && CRC32_TABLE[1] == 0x77073096u);
+}
+
+namespace {
+    bool soa_appends_own_rows() {
+        SoaVector<int, std::string> rows;
+        for (int i = 0; i < 4; ++i)
+            rows.push_back(i, std::string(32, static_cast<char>('a' + i)));
+        if (rows.size() != rows.capacity())
+            return false;
+        rows.push_back(rows.get<0>(0), rows.get<1>(0));
+        rows.emplace_back(rows.get<0>(1), rows.get<1>(1));
+        rows.resize(rows.capacity() + 1, rows.get<0>(2), rows.get<1>(2));
+        bool ok = rows.size() == 9 && rows.get<0>(4) == 0 && rows.get<1>(4) == std::string(32, 'a')
+            && rows.get<0>(5) == 1 && rows.get<1>(5) == std::string(32, 'b');
+        for (size_t i = 6; i < rows.size(); ++i)
+            ok = ok && rows.get<0>(i) == 2 && rows.get<1>(i) == std::string(32, 'c');
+        rows.pop_back();
+        rows.shrink_to_fit();
+        return ok && rows.size() == 8 && rows.capacity() == 8 && std::get<1>(rows.back()) == std::string(32, 'c');
+    }
+
+    struct Fragile {
+        static inline bool fail = false;
+        int val;
+
+        Fragile(int val) : val(val) {}
+
+        Fragile(const Fragile& other) : val(other.val) {
+            if (fail)
+                throw std::runtime_error("Fragile: copy failed");
+        }
+
+        Fragile& operator=(const Fragile& other) = default;
+    };
+
+    bool soa_growth_keeps_rows_on_throw() {
+        SoaVector<std::string, Fragile> rows;
+        for (int i = 0; i < 4; ++i)
+            rows.emplace_back(std::string(32, static_cast<char>('a' + i)), i);
+        bool ok = rows.size() == rows.capacity();
+        Fragile::fail = true;
+        try {
+            rows.emplace_back(std::string(32, 'e'), 4);
+            ok = false;
+        } catch(const std::runtime_error&) {}
+        Fragile::fail = false;
+        ok = ok && rows.size() == 4;
+        for (size_t i = 0; i < rows.size(); ++i)
+            ok = ok && rows.get<0>(i) == std::string(32, static_cast<char>('a' + i)) && rows.get<1>(i).val == int(i);
+        bool rejected = false;
+        try {
+            rows.reserve(SIZE_MAX / 8);
+        } catch(const std::bad_array_new_length&) {
+            rejected = true;
+        }
+        return ok && rejected && rows.size() == 4;
+    }
+
+    bool append_range_from_self() {
+        Vector<std::string> vec{std::string(32, 'a'), std::string(32, 'b')};
+        vec.shrink_to_fit();
+        vec.append_range(vec);
+        bool ok = vec.size() == 4 && vec[2] == std::string(32, 'a') && vec[3] == std::string(32, 'b');
+        vec.shrink_to_fit();
+        vec.append_range(std::span<const std::string>(vec.data() + 1, 2));
+        ok = ok && vec.size() == 6 && vec[4] == std::string(32, 'b') && vec[5] == std::string(32, 'a');
+        vec.reserve(16);
+        vec.append_range(vec);
+        return ok && vec.size() == 12 && vec[11] == std::string(32, 'a');
+    }
+
+    bool jagged_rows_copy_from_self() {
+        JaggedVector<std::string> rows{{std::string(32, 'a'), std::string(32, 'b')}, {std::string(32, 'c')}};
+        rows.shrink_to_fit();
+        rows.push_row(rows.row(0));
+        bool ok = rows.size() == 3 && rows.row_size(2) == 2 && rows[2][1] == std::string(32, 'b');
+        rows.shrink_to_fit();
+        rows.append_last(rows.row(1));
+        ok = ok && rows.row_size(2) == 3 && rows[2][2] == std::string(32, 'c') && rows.value_count() == 6;
+        bool out_of_range = false;
+        try {
+            JaggedVector<int>::from_pairs(2, Vector<std::pair<int, int>>{{0, 1}, {2, 3}});
+        } catch(const std::out_of_range&) {
+            out_of_range = true;
+        }
+        try {
+            JaggedVector<std::string>::from_pairs(2, Vector<std::pair<int, std::string>>{{-1, "x"}});
+            out_of_range = false;
+        } catch(const std::out_of_range&) {
+        }
+        return ok && out_of_range;
+    }
+
+    template <class T>
+    bool erase_mask_matches_remove_if() {
+        Vector<T> vec;
+        Vector<bool> mask;
+        for (size_t i = 0; i < 203; ++i) {
+            vec.push_back(static_cast<T>(i));
+            mask.push_back(i % 7 == 0 || i % 3 == 1 || (i >= 64 && i < 128));
+        }
+        Vector<T> expected = vec;
+        expected.erase(std::remove_if(expected.begin(), expected.end(), [&] (T val) {
+            return mask[static_cast<size_t>(val)];
+        }), expected.end());
+        return vec.erase_mask(mask) == 203 - expected.size() && vec == expected;
+    }
+
+    bool erase_indices_rejects_bad_input() {
+        Vector<int> vec{0, 1, 2, 3, 4};
+        bool out_of_range = false;
+        bool unsorted = false;
+        try {
+            vec.erase_indices(Vector<size_t>{1, 7});
+        } catch(const std::out_of_range&) {
+            out_of_range = true;
+        }
+        try {
+            vec.erase_indices(Vector<size_t>{3, 1});
+        } catch(const std::invalid_argument&) {
+            unsorted = true;
+        }
+        return out_of_range && unsorted && vec == Vector<int>{0, 1, 2, 3, 4};
+    }
+
+    struct Tracked {
+        static inline int live = 0;
+        int val;
+
+        Tracked(int val) : val(val) {
+            ++live;
+        }
+
+        Tracked(const Tracked& other) : val(other.val) {
+            if (val < 0)
+                throw std::runtime_error("Tracked: copy failed");
+            ++live;
+        }
+
+        ~Tracked() {
+            --live;
+        }
+    };
+
+    bool inplace_copy_cleans_up() {
+        bool ok = true;
+        {
+            InplaceVector<Tracked, 4> vec;
+            vec.emplace_back(1);
+            vec.emplace_back(2);
+            vec.emplace_back(-1);
+            try {
+                InplaceVector<Tracked, 4> copy = vec;
+                ok = false;
+            } catch(const std::runtime_error&) {}
+            try {
+                InplaceVector<Tracked, 4> moved = std::move(vec);
+                ok = false;
+            } catch(const std::runtime_error&) {}
+            ok = ok && Tracked::live == 3;
+        }
+        return ok && Tracked::live == 0;
+    }
+
+    bool numa_allocator_maps_large_buffers() {
+        numa::reset_stats();
+        NumaAllocator<int> alloc;
+        int* small = alloc.allocate(16);
+        small[15] = 1;
+        bool ok = !alloc.shrink_in_place(small, 16, 8) && numa::stats().small_allocations == 1;
+        alloc.deallocate(small, 16);
+        const size_t BIG = NumaAllocator<int>::MIN_MAPPED_BYTES / sizeof(int) * 4;
+        int* big = alloc.allocate(BIG);
+        std::fill(big, big + BIG, 7);
+        numa::Stats mapped = numa::stats();
+        if (mapped.mapped_allocations == 1) {
+            ok = ok && mapped.mapped_bytes >= BIG * sizeof(int) && alloc.shrink_in_place(big, BIG, BIG / 2);
+            ok = ok && !alloc.shrink_in_place(big, BIG / 2, 16) && big[BIG / 2 - 1] == 7;
+            alloc.deallocate(big, BIG / 2);
+        } else {
+            ok = ok && mapped.small_allocations == 2;
+            alloc.deallocate(big, BIG);
+        }
+        try {
+            alloc.allocate(SIZE_MAX / sizeof(int) + (size_t(1) << 20) + 1);
+            ok = false;
+        } catch(const std::bad_array_new_length&) {}
+        Vector<int> data(10007);
+        numa::first_touch(std::span<int>(data), 4, [] (std::span<int> part, size_t w) {
+            std::fill(part.begin(), part.end(), static_cast<int>(w) + 1);
+        });
+        ok = ok && data.front() == 1 && data.back() == 4 && std::count(data.begin(), data.end(), 0) == 0;
+        ok = ok && numa::stats().touched_slices == 4;
+        std::atomic<size_t> ran{0};
+        try {
+            numa::first_touch(std::span<int>(data), 4, [&] (std::span<int>, size_t w) {
+                ++ran;
+                if (w == 2)
+                    throw std::runtime_error("first_touch: worker failed");
+            });
+            ok = false;
+        } catch(const std::runtime_error&) {}
+        return ok && ran == 4;
+    }
+
+    struct StatsProbe {
+        int val;
+    };
+
+    bool stats_count_vector_work() {
+        if constexpr (!vector_stats::ENABLED) {
+            return true;
+        } else {
+            vector_stats::reset();
+            Vector<StatsProbe> vec;
+            vec.reserve(4);
+            for (int i = 0; i < 8; ++i)
+                vec.push_back(StatsProbe{i});
+            vector_stats::Counters grown = vector_stats::totals<StatsProbe>();
+            bool ok = grown.allocations == 2 && grown.reallocations == 1 && grown.relocated == 4 && grown.peak_capacity == 8;
+            vector_stats::reset();
+            vec.erase_indices(Vector<size_t>{5});
+            ok = ok && vector_stats::totals<StatsProbe>().moved == 2;
+            Vector<bool> mask(vec.size());
+            mask[5] = true;
+            vector_stats::reset();
+            vec.erase_mask(mask);
+            ok = ok && vector_stats::totals<StatsProbe>().moved == 1 && vec.size() == 6 && vec.back().val == 7;
+            std::thread worker([] {
+                Vector<StatsProbe> local(3, StatsProbe{1});
+                local.push_back(StatsProbe{2});
+            });
+            worker.join();
+            vector_stats::Counters joined = vector_stats::totals<StatsProbe>();
+            return ok && joined.allocations == 2 && joined.reallocations == 1 && joined.relocated == 3;
+        }
+    }
+
+    bool thread_pool_forks_and_joins() {
+        ThreadPool pool(4);
+        Vector<std::atomic<int>> hits(100000);
+        pool.parallel_for(0, hits.size(), 1000, [&] (size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        bool ok = std::all_of(hits.begin(), hits.end(), [] (const std::atomic<int>& hit) {
+            return hit.load(std::memory_order_relaxed) == 1;
+        });
+        bool left_ran = false;
+        bool caught = false;
+        try {
+            pool.fork_join([&] { left_ran = true; }, [] { throw std::runtime_error("fork_join: right failed"); });
+        } catch(const std::runtime_error&) {
+            caught = true;
+        }
+        return ok && left_ran && caught;
+    }
+
+    bool pool_reclaims_remote_frees() {
+        PoolAllocator<int> alloc;
+        pool::trim();
+        pool::reset_thread_stats();
+        Vector<int*> blocks;
+        for (size_t i = 0; i < 4; ++i)
+            blocks.push_back(alloc.allocate(10));
+        pool::Stats remote;
+        std::thread worker([&] {
+            for (int* block : blocks)
+                alloc.deallocate(block, 10);
+            remote = pool::thread_stats();
+        });
+        worker.join();
+        bool ok = remote.remote_frees == 4 && remote.local_frees == 0;
+        for (size_t i = 0; i < 4; ++i) {
+            int* block = alloc.allocate(10);
+            ok = ok && std::find(blocks.begin(), blocks.end(), block) != blocks.end();
+            blocks[i] = block;
+        }
+        pool::Stats owner = pool::thread_stats();
+        ok = ok && owner.misses == 4 && owner.hits == 4 && owner.remote_reclaimed == 4;
+        for (int* block : blocks)
+            alloc.deallocate(block, 10);
+        return ok && pool::thread_stats().local_frees == 4;
+    }
+
+    bool pool_caps_thread_cache() {
+        PoolAllocator<int> alloc;
+        const size_t BLOCK = pool::class_bytes(pool::size_class(10 * sizeof(int)));
+        pool::Limits saved = pool::limits();
+        auto cycle = [&] (size_t cnt) {
+            pool::trim();
+            Vector<int*> blocks;
+            for (size_t i = 0; i < cnt; ++i)
+                blocks.push_back(alloc.allocate(10));
+            pool::reset_thread_stats();
+            for (int* block : blocks)
+                alloc.deallocate(block, 10);
+            return pool::thread_stats().released;
+        };
+        pool::set_limits({saved.thread_bytes, 2 * BLOCK});
+        bool ok = pool::limits().class_bytes == 2 * BLOCK && cycle(5) == 3;
+        pool::set_limits({BLOCK, saved.class_bytes});
+        ok = ok && cycle(3) == 2;
+        pool::set_limits(saved);
+        ok = ok && cycle(3) == 0;
+        pool::trim();
+        return ok;
+    }
+
+    bool atomic_bits_race_and_count() {
+        const size_t BITS = 1000;
+        const size_t THREADS = 8;
+        Vector<bool> bits(BITS);
+        AtomicBitView view(bits);
+        Vector<std::atomic<int>> wins(BITS);
+        Vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = 0; i < BITS; ++i) {
+                    size_t idx = (i * 7 + t * 131) % BITS;
+                    if (!view.test_and_set(idx))
+                        wins[idx].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        bool ok = std::all_of(wins.begin(), wins.end(), [] (const std::atomic<int>& win) {
+            return win.load(std::memory_order_relaxed) == 1;
+        });
+        ok = ok && view.count() == BITS && bits.count() == BITS;
+        view.test_and_reset(BITS - 1);
+        uint64_t old = view.fetch_or(view.words().size() - 1, ~uint64_t(0));
+        ok = ok && old >> (BITS % 64 - 1) == 0 && bits.words().back() >> (BITS % 64) == 0 && bits.count() == BITS;
+        ThreadPool pool(4);
+        Vector<bool> large(300007);
+        for (size_t i = 0; i < large.size(); i += 3)
+            large[i] = true;
+        AtomicBitView large_view(large);
+        large_view.fetch_or(large_view.words().size() - 1, ~uint64_t(0));
+        size_t serial = large_view.count();
+        return ok && serial == large.count() && large_view.count(pool) == serial;
+    }
+
+    bool parallel_algorithms_match_serial() {
+        ThreadPool pool(4);
+        Vector<int64_t> keys(100000);
+        uint64_t state = 1;
+        for (int64_t& key : keys) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            key = static_cast<int64_t>(state >> 20) - (int64_t(1) << 43);
+        }
+        Vector<int64_t> radix = keys;
+        parallel_radix_sort(radix, pool);
+        Vector<std::pair<int64_t, size_t>> pairs;
+        for (size_t i = 0; i < keys.size(); ++i)
+            pairs.emplace_back(keys[i] % 1000, i);
+        Vector<std::pair<int64_t, size_t>> expected = pairs;
+        std::stable_sort(expected.begin(), expected.end(), [] (const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        parallel_sort(pairs, [] (auto& lhs, auto& rhs) { return lhs.first < rhs.first; }, pool);
+        Vector<int64_t> doubled;
+        parallel_transform(keys, doubled, [] (int64_t key) { return key * 2; }, pool);
+        int64_t sum = parallel_reduce(keys, int64_t(0), std::plus<>(), pool);
+        int64_t doubled_sum = 0;
+        for (int64_t key : doubled)
+            doubled_sum += key;
+        return std::is_sorted(radix.begin(), radix.end()) && radix.size() == keys.size() && pairs == expected
+            && doubled.size() == keys.size() && doubled_sum == 2 * sum;
+    }
+
+    bool bool_spans_are_checked() {
+        Vector<bool> bits(70, true);
+        std::byte bytes[8] = {};
+        uint64_t words[1] = {};
+        size_t failures = 0;
+        try {
+            bits.to_bytes(bytes);
+        } catch(const std::length_error&) {
+            ++failures;
+        }
+        try {
+            Vector<bool>::from_bytes(bytes, 70);
+        } catch(const std::length_error&) {
+            ++failures;
+        }
+        try {
+            bits.assign(words, 70);
+        } catch(const std::length_error&) {
+            ++failures;
+        }
+        return failures == 3 && bits.size() == 70 && bits.count() == 70;
+    }
+
+    bool bool_adopt_checks_buffers() {
+        std::allocator<uint64_t> words;
+        uint64_t* first = words.allocate(2);
+        first[0] = ~uint64_t(0);
+        first[1] = ~uint64_t(0);
+        Vector<bool> bits(adopt_words, first, 2, 70);
+        bool ok = bits.size() == 70 && bits.count() == 70 && bits.capacity() == 128;
+        uint64_t* second = words.allocate(1);
+        second[0] = 5;
+        size_t failures = 0;
+        try {
+            bits.assign(adopt_words, second, 1, 65);
+        } catch(const std::length_error&) {
+            ++failures;
+        }
+        try {
+            bits.assign(adopt_words, bits.words().data(), 2, 70);
+        } catch(const std::invalid_argument&) {
+            ++failures;
+        }
+        try {
+            Vector<bool> oversized(adopt_words, second, SIZE_MAX / 32, 70);
+        } catch(const std::length_error&) {
+            ++failures;
+        }
+        ok = ok && failures == 3 && bits.size() == 70 && bits.count() == 70;
+        bits.assign(adopt_words, second, 1, 3);
+        return ok && bits.size() == 3 && bits.count() == 2 && bits.capacity() == 64;
+    }
+
+    bool calloc_rejects_overflow() {
+        bool plain = false;
+        bool zeroed = false;
+        try {
+            CallocAllocator<uint64_t>().allocate(SIZE_MAX / 4);
+        } catch(const std::bad_array_new_length&) {
+            plain = true;
+        }
+        try {
+            CallocAllocator<uint64_t>().allocate_zeroed(SIZE_MAX / 4);
+        } catch(const std::bad_array_new_length&) {
+            zeroed = true;
+        }
+        return plain && zeroed;
+    }
+
+    bool padded_tail_stays_zero() {
+        AlignedVector<int, 32> vec(13, 7);
+        auto tail_zero = [&] {
+            std::span<const int> view = std::as_const(vec).padded_span();
+            return view.size() % 8 == 0 && std::all_of(view.begin() + vec.size(), view.end(), [] (int x) {
+                return x == 0;
+            });
+        };
+        bool ok = tail_zero();
+        vec.pop_back();
+        ok = tail_zero() && ok;
+        vec.erase(vec.begin() + 2, vec.begin() + 5);
+        ok = tail_zero() && ok;
+        vec.resize(5);
+        ok = tail_zero() && ok;
+        vec.insert(vec.begin() + 1, 2, 9);
+        ok = tail_zero() && ok;
+        vec.push_back(3);
+        ok = tail_zero() && ok;
+        vec.reserve(100);
+        ok = tail_zero() && ok;
+        vec.shrink_to_fit();
+        ok = tail_zero() && ok;
+        vec.clear();
+        return tail_zero() && ok;
+    }
+}
 
 int main() {
-    Vector<int> vec;
-    return 0;
+    bool ok = soa_appends_own_rows();
+    ok = append_range_from_self() && ok;
+    ok = jagged_rows_copy_from_self() && ok;
+    ok = erase_mask_matches_remove_if<int32_t>() && erase_mask_matches_remove_if<double>() && ok;
+    ok = soa_growth_keeps_rows_on_throw() && ok;
+    ok = erase_indices_rejects_bad_input() && ok;
+    ok = padded_tail_stays_zero() && ok;
+    ok = calloc_rejects_overflow() && ok;
+    ok = bool_spans_are_checked() && ok;
+    ok = bool_adopt_checks_buffers() && ok;
+    ok = inplace_copy_cleans_up() && ok;
+    ok = numa_allocator_maps_large_buffers() && ok;
+    ok = stats_count_vector_work() && ok;
+    ok = thread_pool_forks_and_joins() && ok;
+    ok = atomic_bits_race_and_count() && ok;
+    ok = pool_reclaims_remote_frees() && ok;
+    ok = pool_caps_thread_cache() && ok;
+    ok = parallel_algorithms_match_serial() && ok;
+    return ok ? 0 : 1;
 }
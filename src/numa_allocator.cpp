@@ -0,0 +1,341 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "numa_allocator.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include "vector.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <span>
+#include <thread>
+#include <utility>
+#if __has_include(<linux/mempolicy.h>) && __has_include(<sys/mman.h>)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define VECTOR_HAS_NUMA_SYSCALLS
+#endif
+
+namespace detail::numa {
+const size_t MASK_BITS = sizeof(unsigned long) * 8;
+const size_t MASK_WORDS = ::numa::MAX_NODES / MASK_BITS;
+const size_t NODE_LIST_SIZE = 256;
+const char* const ONLINE_NODES_PATH = "/sys/devices/system/node/online";
+
+struct Counters {
+    std::atomic<size_t> mapped_allocations{0};
+    std::atomic<size_t> mapped_bytes{0};
+    std::atomic<size_t> small_allocations{0};
+    std::atomic<size_t> policy_calls{0};
+    std::atomic<size_t> policy_failures{0};
+    std::atomic<size_t> policy_skipped{0};
+    std::atomic<size_t> touched_slices{0};
+};
+
+inline auto counters() noexcept -> Counters& {
+    static Counters res;
+    return res;
+}
+
+inline auto read_node_count() noexcept -> size_t {
+    FILE* file = fopen(ONLINE_NODES_PATH, "r");
+    if (file == nullptr)
+        return 1;
+    char buf[NODE_LIST_SIZE];
+    size_t res = 1;
+    if (fgets(buf, sizeof(buf), file) != nullptr) {
+        const char* cur = buf;
+        while (true) {
+            char* end = nullptr;
+            size_t node = strtoul(cur, &end, 10);
+            if (end == cur)
+                break;
+            if (node + 1 > res)
+                res = node + 1;
+            cur = end;
+            if (*cur != '-' && *cur != ',')
+                break;
+            ++cur;
+        }
+    }
+    fclose(file);
+    return res < ::numa::MAX_NODES ? res : ::numa::MAX_NODES;
+}
+
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+struct Mode {
+    int mode;
+    unsigned long mask[MASK_WORDS];
+    bool has_mask;
+};
+
+inline auto make_mode(::numa::Policy policy, int node) noexcept -> Mode {
+    Mode res{MPOL_DEFAULT, {}, false};
+    switch (policy) {
+    case ::numa::Policy::LOCAL:
+        res.mode = MPOL_LOCAL;
+        break;
+    case ::numa::Policy::PREFERRED:
+    case ::numa::Policy::BIND:
+        res.mode = policy == ::numa::Policy::BIND ? MPOL_BIND : MPOL_PREFERRED;
+        res.mask[node / MASK_BITS] |= 1ul << (node % MASK_BITS);
+        res.has_mask = true;
+        break;
+    case ::numa::Policy::INTERLEAVE:
+        res.mode = MPOL_INTERLEAVE;
+        for (size_t i = 0; i < ::numa::node_count(); ++i)
+            res.mask[i / MASK_BITS] |= 1ul << (i % MASK_BITS);
+        res.has_mask = true;
+        break;
+    default:
+        break;
+    }
+    return res;
+}
+
+inline auto page_size() noexcept -> size_t {
+    static const size_t res = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return res;
+}
+
+inline auto record_policy_call(long res) noexcept -> bool {
+    ++counters().policy_calls;
+    if (res != 0)
+        ++counters().policy_failures;
+    return res == 0;
+}
+#endif
+}
+
+inline auto numa::supported() noexcept -> bool {
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline auto numa::node_count() noexcept -> size_t {
+    static const size_t res = detail::numa::read_node_count();
+    return res;
+}
+
+inline auto numa::current_node() noexcept -> int {
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return static_cast<int>(node);
+#endif
+    return 0;
+}
+
+inline auto numa::bind_memory(void* addr, size_t len, Policy policy, int node) noexcept -> bool {
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    if (node < 0 || static_cast<size_t>(node) >= node_count())
+        return false;
+    if (node_count() == 1 || policy == Policy::DEFAULT) {
+        ++detail::numa::counters().policy_skipped;
+        return true;
+    }
+    if (policy == Policy::PARTITIONED) {
+        size_t page = detail::numa::page_size();
+        size_t chunk = (len / node_count() + page - 1) / page * page;
+        bool res = true;
+        for (size_t i = 0; i < node_count() && i * chunk < len; ++i) {
+            size_t part = len - i * chunk < chunk ? len - i * chunk : chunk;
+            res &= bind_memory(static_cast<char*>(addr) + i * chunk, part, Policy::BIND, static_cast<int>(i));
+        }
+        return res;
+    }
+    detail::numa::Mode mode = detail::numa::make_mode(policy, node);
+    return detail::numa::record_policy_call(syscall(SYS_mbind, addr, len, mode.mode,
+        mode.has_mask ? mode.mask : nullptr, mode.has_mask ? MAX_NODES + 1 : 0, 0));
+#else
+    (void)addr;
+    (void)len;
+    (void)policy;
+    (void)node;
+    return false;
+#endif
+}
+
+inline auto numa::set_thread_policy(Policy policy, int node) noexcept -> bool {
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    if (policy == Policy::PARTITIONED || node < 0 || static_cast<size_t>(node) >= node_count())
+        return false;
+    if (node_count() == 1) {
+        ++detail::numa::counters().policy_skipped;
+        return true;
+    }
+    detail::numa::Mode mode = detail::numa::make_mode(policy, node);
+    return detail::numa::record_policy_call(syscall(SYS_set_mempolicy, mode.mode,
+        mode.has_mask ? mode.mask : nullptr, mode.has_mask ? MAX_NODES + 1 : 0));
+#else
+    (void)policy;
+    (void)node;
+    return false;
+#endif
+}
+
+inline auto numa::stats() noexcept -> Stats {
+    detail::numa::Counters& cnt = detail::numa::counters();
+    Stats res;
+    res.mapped_allocations = cnt.mapped_allocations;
+    res.mapped_bytes = cnt.mapped_bytes;
+    res.small_allocations = cnt.small_allocations;
+    res.policy_calls = cnt.policy_calls;
+    res.policy_failures = cnt.policy_failures;
+    res.policy_skipped = cnt.policy_skipped;
+    res.touched_slices = cnt.touched_slices;
+    return res;
+}
+
+inline auto numa::reset_stats() noexcept -> void {
+    detail::numa::Counters& cnt = detail::numa::counters();
+    cnt.mapped_allocations = 0;
+    cnt.mapped_bytes = 0;
+    cnt.small_allocations = 0;
+    cnt.policy_calls = 0;
+    cnt.policy_failures = 0;
+    cnt.policy_skipped = 0;
+    cnt.touched_slices = 0;
+}
+
+template <class T, class F>
+auto numa::first_touch(std::span<T> data, size_t workers, F&& init) -> void {
+    if (workers == 0)
+        workers = 1;
+    Vector<std::exception_ptr> errors(workers);
+    Vector<std::thread> threads;
+    threads.reserve(workers);
+    try {
+        for (size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w] {
+                size_t first = data.size() * w / workers;
+                size_t last = data.size() * (w + 1) / workers;
+                bool bound = set_thread_policy(Policy::PREFERRED, static_cast<int>(w * node_count() / workers));
+                try {
+                    init(data.subspan(first, last - first), w);
+                } catch(...) {
+                    errors[w] = std::current_exception();
+                }
+                if (bound)
+                    set_thread_policy(Policy::DEFAULT);
+            });
+        }
+    } catch(...) {
+        for (std::thread& thread : threads)
+            thread.join();
+        throw;
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    detail::numa::counters().touched_slices += workers;
+    for (const std::exception_ptr& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+template <class T>
+constexpr NumaAllocator<T>::NumaAllocator(numa::Policy policy, int node) noexcept
+: pol(policy), nd(node) {}
+
+template <class T>
+template <class U>
+constexpr NumaAllocator<T>::NumaAllocator(const NumaAllocator<U>& other) noexcept
+: pol(other.policy()), nd(other.node()) {}
+
+template <class T>
+auto NumaAllocator<T>::mapped_size(size_t cnt) noexcept -> size_t {
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    size_t bytes = cnt * sizeof(T);
+    if (bytes < MIN_MAPPED_BYTES)
+        return 0;
+    size_t page = detail::numa::page_size();
+    return (bytes + page - 1) / page * page;
+#else
+    (void)cnt;
+    return 0;
+#endif
+}
+
+template <class T>
+auto NumaAllocator<T>::allocate(size_t cnt) -> T* {
+    if (cnt > SIZE_MAX / sizeof(T))
+        throw std::bad_array_new_length();
+    size_t len = mapped_size(cnt);
+    if (len == 0) {
+        ++detail::numa::counters().small_allocations;
+        return std::allocator<T>().allocate(cnt);
+    }
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    void* res = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED)
+        throw std::bad_alloc();
+    numa::bind_memory(res, len, pol, nd);
+    ++detail::numa::counters().mapped_allocations;
+    detail::numa::counters().mapped_bytes += len;
+    return static_cast<T*>(res);
+#else
+    return nullptr;
+#endif
+}
+
+template <class T>
+auto NumaAllocator<T>::allocate_zeroed(size_t cnt) -> T* {
+    T* res = allocate(cnt);
+    if (mapped_size(cnt) == 0 && cnt != 0)
+        std::memset(static_cast<void*>(res), 0, cnt * sizeof(T));
+    return res;
+}
+
+template <class T>
+auto NumaAllocator<T>::deallocate(T* ptr, size_t cnt) noexcept -> void {
+    size_t len = mapped_size(cnt);
+    if (len == 0) {
+        std::allocator<T>().deallocate(ptr, cnt);
+        return;
+    }
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    munmap(ptr, len);
+#endif
+}
+
+template <class T>
+auto NumaAllocator<T>::shrink_in_place(T* ptr, size_t old_cnt, size_t new_cnt) noexcept -> bool {
+    size_t old_len = mapped_size(old_cnt);
+    size_t new_len = mapped_size(new_cnt);
+    if (old_len == 0 || new_len == 0)
+        return false;
+#ifdef VECTOR_HAS_NUMA_SYSCALLS
+    if (new_len < old_len)
+        munmap(reinterpret_cast<char*>(ptr) + new_len, old_len - new_len);
+#endif
+    return true;
+}
+
+template <class T>
+constexpr auto NumaAllocator<T>::policy() const noexcept -> numa::Policy {
+    return pol;
+}
+
+template <class T>
+constexpr auto NumaAllocator<T>::node() const noexcept -> int {
+    return nd;
+}
+
+template <class T>
+template <class U>
+constexpr auto NumaAllocator<T>::operator==(const NumaAllocator<U>& other) const noexcept -> bool {
+    return pol == other.policy() && nd == other.node();
+}
@@ -0,0 +1,70 @@
+#ifndef NUMA_ALLOCATOR_H
+
+#define NUMA_ALLOCATOR_H
+
+#include <cstddef>
+#include <span>
+
+namespace numa {
+enum class Policy {
+    DEFAULT,
+    LOCAL,
+    PREFERRED,
+    BIND,
+    INTERLEAVE,
+    PARTITIONED
+};
+
+struct Stats {
+    size_t mapped_allocations = 0;
+    size_t mapped_bytes = 0;
+    size_t small_allocations = 0;
+    size_t policy_calls = 0;
+    size_t policy_failures = 0;
+    size_t policy_skipped = 0;
+    size_t touched_slices = 0;
+};
+
+const size_t MAX_NODES = 256;
+
+bool supported() noexcept;
+size_t node_count() noexcept;
+int current_node() noexcept;
+bool bind_memory(void* addr, size_t len, Policy policy, int node = 0) noexcept;
+bool set_thread_policy(Policy policy, int node = 0) noexcept;
+Stats stats() noexcept;
+void reset_stats() noexcept;
+template <class T, class F>
+void first_touch(std::span<T> data, size_t workers, F&& init);
+}
+
+template <class T>
+class NumaAllocator {
+public:
+    using value_type = T;
+    static const size_t MIN_MAPPED_BYTES = 1 << 16;
+    constexpr NumaAllocator() noexcept = default;
+    explicit constexpr NumaAllocator(numa::Policy policy, int node = 0) noexcept;
+    template <class U>
+    constexpr NumaAllocator(const NumaAllocator<U>& other) noexcept;
+    T* allocate(size_t cnt);
+    T* allocate_zeroed(size_t cnt);
+    void deallocate(T* ptr, size_t cnt) noexcept;
+    bool shrink_in_place(T* ptr, size_t old_cnt, size_t new_cnt) noexcept;
+    constexpr numa::Policy policy() const noexcept;
+    constexpr int node() const noexcept;
+    template <class U>
+    constexpr bool operator==(const NumaAllocator<U>& other) const noexcept;
+private:
+    static size_t mapped_size(size_t cnt) noexcept;
+    numa::Policy pol = numa::Policy::INTERLEAVE;
+    int nd = 0;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "numa_allocator.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
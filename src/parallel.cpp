@@ -0,0 +1,166 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "parallel.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace detail::parallel {
+const size_t RADIX_BITS = 11;
+const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+const size_t MIN_RADIX_BLOCK = size_t(1) << 16;
+const size_t MIN_RADIX_SORT = size_t(1) << 12;
+const size_t SORT_GRAIN = size_t(1) << 14;
+const size_t MERGE_GRAIN = size_t(1) << 14;
+const size_t FOR_GRAIN = size_t(1) << 14;
+
+template <class T>
+constexpr auto radix_key(T val) noexcept -> std::make_unsigned_t<T> {
+    using Key = std::make_unsigned_t<T>;
+    Key res = static_cast<Key>(val);
+    if constexpr (std::is_signed_v<T>)
+        res ^= Key(1) << (sizeof(T) * 8 - 1);
+    return res;
+}
+
+template <class T>
+auto radix_pass(const T* src, T* dst, size_t cnt, size_t shift, size_t blocks, Vector<size_t>& counts,
+    ThreadPool& pool) -> bool {
+    std::fill(counts.begin(), counts.end(), 0);
+    pool.parallel_for(0, blocks, 1, [&] (size_t first, size_t last) {
+        for (size_t block = first; block < last; ++block) {
+            size_t* hist = counts.data() + block * RADIX_BUCKETS;
+            for (size_t i = cnt * block / blocks; i < cnt * (block + 1) / blocks; ++i)
+                ++hist[(radix_key(src[i]) >> shift) & (RADIX_BUCKETS - 1)];
+        }
+    });
+    for (size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+        size_t total = 0;
+        for (size_t block = 0; block < blocks; ++block)
+            total += counts[block * RADIX_BUCKETS + digit];
+        if (total == cnt)
+            return false;
+    }
+    size_t offset = 0;
+    for (size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+        for (size_t block = 0; block < blocks; ++block)
+            offset += std::exchange(counts[block * RADIX_BUCKETS + digit], offset);
+    }
+    pool.parallel_for(0, blocks, 1, [&] (size_t first, size_t last) {
+        for (size_t block = first; block < last; ++block) {
+            size_t* pos = counts.data() + block * RADIX_BUCKETS;
+            for (size_t i = cnt * block / blocks; i < cnt * (block + 1) / blocks; ++i)
+                dst[pos[(radix_key(src[i]) >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+        }
+    });
+    return true;
+}
+
+template <class T, class Compare>
+auto merge(T* lhs, size_t lhs_cnt, T* rhs, size_t rhs_cnt, T* out, Compare& comp, ThreadPool& pool) -> void {
+    if (lhs_cnt + rhs_cnt <= MERGE_GRAIN) {
+        T* lhs_end = lhs + lhs_cnt;
+        T* rhs_end = rhs + rhs_cnt;
+        while (lhs != lhs_end && rhs != rhs_end)
+            *out++ = comp(*rhs, *lhs) ? std::move(*rhs++) : std::move(*lhs++);
+        std::move(rhs, rhs_end, std::move(lhs, lhs_end, out));
+        return;
+    }
+    size_t lhs_mid = lhs_cnt / 2;
+    size_t rhs_mid = rhs_cnt / 2;
+    if (lhs_cnt >= rhs_cnt)
+        rhs_mid = std::lower_bound(rhs, rhs + rhs_cnt, lhs[lhs_mid], comp) - rhs;
+    else
+        lhs_mid = std::upper_bound(lhs, lhs + lhs_cnt, rhs[rhs_mid], comp) - lhs;
+    pool.fork_join([&] { merge(lhs, lhs_mid, rhs, rhs_mid, out, comp, pool); }, [&] {
+        merge(lhs + lhs_mid, lhs_cnt - lhs_mid, rhs + rhs_mid, rhs_cnt - rhs_mid, out + lhs_mid + rhs_mid, comp, pool);
+    });
+}
+
+template <class T, class Compare>
+auto merge_sort(T* data, T* buf, size_t cnt, bool to_buf, Compare& comp, ThreadPool& pool) -> void {
+    if (cnt <= SORT_GRAIN) {
+        std::stable_sort(data, data + cnt, comp);
+        if (to_buf)
+            std::move(data, data + cnt, buf);
+        return;
+    }
+    size_t half = cnt / 2;
+    pool.fork_join([&] { merge_sort(data, buf, half, !to_buf, comp, pool); },
+        [&] { merge_sort(data + half, buf + half, cnt - half, !to_buf, comp, pool); });
+    if (to_buf)
+        merge(data, half, data + half, cnt - half, buf, comp, pool);
+    else
+        merge(buf, half, buf + half, cnt - half, data, comp, pool);
+}
+}
+
+template <class T, class Alloc, class Size>
+requires std::integral<T> && (!std::same_as<T, bool>)
+auto parallel_radix_sort(Vector<T, Alloc, Size>& vec, ThreadPool& pool) -> void {
+    using namespace detail::parallel;
+    size_t cnt = vec.size();
+    if (cnt < MIN_RADIX_SORT) {
+        std::sort(vec.begin(), vec.end());
+        return;
+    }
+    size_t blocks = std::clamp<size_t>(cnt / MIN_RADIX_BLOCK, 1, pool.size());
+    Vector<T, Alloc, Size> buf(cnt, vec.get_allocator());
+    Vector<size_t> counts(blocks * RADIX_BUCKETS);
+    T* src = vec.data();
+    T* dst = buf.data();
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += RADIX_BITS) {
+        if (radix_pass(src, dst, cnt, shift, blocks, counts, pool))
+            std::swap(src, dst);
+    }
+    if (src != vec.data())
+        vec.swap(buf);
+}
+
+template <class T, class Alloc, class Size, class Compare>
+auto parallel_sort(Vector<T, Alloc, Size>& vec, Compare comp, ThreadPool& pool) -> void {
+    if (vec.size() <= detail::parallel::SORT_GRAIN || pool.size() == 1) {
+        std::stable_sort(vec.begin(), vec.end(), comp);
+        return;
+    }
+    Vector<T, Alloc, Size> buf(std::make_move_iterator(vec.begin()), std::make_move_iterator(vec.end()),
+        vec.get_allocator());
+    detail::parallel::merge_sort(buf.data(), vec.data(), vec.size(), true, comp, pool);
+}
+
+template <class T, class Alloc, class Size, class U, class UAlloc, class USize, class F>
+auto parallel_transform(const Vector<T, Alloc, Size>& in, Vector<U, UAlloc, USize>& out, F op, ThreadPool& pool)
+-> void {
+    static_assert(!std::is_same_v<Vector<U, UAlloc, USize>, Vector<bool, UAlloc>>,
+        "parallel_transform: packed Vector<bool> bits cannot be written concurrently");
+    out.resize(in.size());
+    pool.parallel_for(0, in.size(), detail::parallel::FOR_GRAIN, [&] (size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            out[i] = op(in[i]);
+    });
+}
+
+template <class T, class Alloc, class Size, class U, class BinaryOp>
+auto parallel_reduce(const Vector<T, Alloc, Size>& vec, U init, BinaryOp op, ThreadPool& pool) -> U {
+    using detail::parallel::FOR_GRAIN;
+    size_t cnt = vec.size();
+    Vector<std::optional<U>> partials((cnt + FOR_GRAIN - 1) / FOR_GRAIN);
+    pool.parallel_for(0, partials.size(), 1, [&] (size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; ++chunk) {
+            size_t begin = chunk * FOR_GRAIN;
+            size_t end = std::min(cnt, begin + FOR_GRAIN);
+            U acc = vec[begin];
+            for (size_t i = begin + 1; i < end; ++i)
+                acc = op(std::move(acc), vec[i]);
+            partials[chunk].emplace(std::move(acc));
+        }
+    });
+    for (std::optional<U>& partial : partials)
+        init = op(std::move(init), std::move(*partial));
+    return init;
+}
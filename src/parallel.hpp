@@ -0,0 +1,32 @@
+#ifndef PARALLEL_H
+
+#define PARALLEL_H
+
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#include <concepts>
+#include <cstddef>
+#include <functional>
+
+template <class T, class Alloc, class Size>
+requires std::integral<T> && (!std::same_as<T, bool>)
+void parallel_radix_sort(Vector<T, Alloc, Size>& vec, ThreadPool& pool = ThreadPool::shared());
+
+template <class T, class Alloc, class Size, class Compare = std::less<>>
+void parallel_sort(Vector<T, Alloc, Size>& vec, Compare comp = Compare(), ThreadPool& pool = ThreadPool::shared());
+
+template <class T, class Alloc, class Size, class U, class UAlloc, class USize, class F>
+void parallel_transform(const Vector<T, Alloc, Size>& in, Vector<U, UAlloc, USize>& out, F op,
+    ThreadPool& pool = ThreadPool::shared());
+
+template <class T, class Alloc, class Size, class U, class BinaryOp = std::plus<>>
+U parallel_reduce(const Vector<T, Alloc, Size>& vec, U init, BinaryOp op = BinaryOp(),
+    ThreadPool& pool = ThreadPool::shared());
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "parallel.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "perf_counters.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define VECTOR_HAS_PERF_EVENTS
+#endif
+
+namespace detail::perf {
+#ifdef VECTOR_HAS_PERF_EVENTS
+inline auto cache_config(uint64_t cache, uint64_t op, uint64_t result) noexcept -> uint64_t {
+    return cache | (op << 8) | (result << 16);
+}
+
+inline auto open_event(PerfCounters::Event event, int group_fd) noexcept -> int {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = group_fd < 0;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    switch (event) {
+    case PerfCounters::CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PerfCounters::INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PerfCounters::L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_config(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+    case PerfCounters::LLC_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case PerfCounters::BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PerfCounters::DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+    default:
+        return -1;
+    }
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+}
+
+inline auto PerfCounters::Sample::per(Event event, size_t ops) const noexcept -> double {
+    if (!valid[event] || ops == 0)
+        return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(values[event]) / ops;
+}
+
+inline auto PerfCounters::name(Event event) noexcept -> const char* {
+    static const char* const NAMES[EVENT_COUNT] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+    };
+    return NAMES[event];
+}
+
+inline PerfCounters::PerfCounters() noexcept {
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+#ifdef VECTOR_HAS_PERF_EVENTS
+        fds[i] = detail::perf::open_event(static_cast<Event>(i), leader);
+        if (leader < 0)
+            leader = fds[i];
+#else
+        fds[i] = -1;
+#endif
+    }
+}
+
+inline PerfCounters::~PerfCounters() {
+#ifdef VECTOR_HAS_PERF_EVENTS
+    for (int fd : fds)
+        if (fd >= 0 && fd != leader)
+            close(fd);
+    if (leader >= 0)
+        close(leader);
+#endif
+}
+
+inline auto PerfCounters::available() const noexcept -> bool {
+    for (int fd : fds)
+        if (fd >= 0)
+            return true;
+    return false;
+}
+
+inline auto PerfCounters::available(Event event) const noexcept -> bool {
+    return fds[event] >= 0;
+}
+
+inline auto PerfCounters::start() noexcept -> void {
+#ifdef VECTOR_HAS_PERF_EVENTS
+    if (leader < 0)
+        return;
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+inline auto PerfCounters::stop() noexcept -> void {
+#ifdef VECTOR_HAS_PERF_EVENTS
+    if (leader < 0)
+        return;
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t buf[3 + EVENT_COUNT];
+    ssize_t got = read(leader, buf, sizeof(buf));
+    if (got < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+        return;
+    uint64_t enabled = buf[1];
+    uint64_t running = buf[2];
+    time_enabled += enabled;
+    time_running += running;
+    if (running == 0)
+        return;
+    size_t cnt = std::min<size_t>(buf[0], got / sizeof(uint64_t) - 3);
+    size_t slot = 0;
+    for (size_t i = 0; i < EVENT_COUNT; ++i) {
+        if (fds[i] < 0)
+            continue;
+        if (slot < cnt)
+            totals[i] += static_cast<uint64_t>(static_cast<double>(buf[3 + slot]) * enabled / running);
+        ++slot;
+    }
+#endif
+}
+
+inline auto PerfCounters::reset() noexcept -> void {
+    totals.fill(0);
+    time_enabled = 0;
+    time_running = 0;
+}
+
+inline auto PerfCounters::sample() const noexcept -> Sample {
+    Sample res;
+    res.values = totals;
+    for (size_t i = 0; i < EVENT_COUNT; ++i)
+        res.valid[i] = fds[i] >= 0 && time_running != 0;
+    if (time_enabled != 0)
+        res.running = static_cast<double>(time_running) / time_enabled;
+    return res;
+}
+
+inline PerfScope::PerfScope(PerfCounters& counters) noexcept
+: counters(counters) {
+    counters.start();
+}
+
+inline PerfScope::~PerfScope() {
+    counters.stop();
+}
@@ -0,0 +1,61 @@
+#ifndef PERF_COUNTERS_H
+
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class PerfCounters {
+public:
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        DTLB_MISSES,
+        EVENT_COUNT
+    };
+    struct Sample {
+        std::array<uint64_t, EVENT_COUNT> values{};
+        std::array<bool, EVENT_COUNT> valid{};
+        double running = 0;
+        double per(Event event, size_t ops) const noexcept;
+    };
+    static const char* name(Event event) noexcept;
+    PerfCounters() noexcept;
+    PerfCounters(const PerfCounters& other) = delete;
+    PerfCounters& operator=(const PerfCounters& other) = delete;
+    ~PerfCounters();
+    bool available() const noexcept;
+    bool available(Event event) const noexcept;
+    void start() noexcept;
+    void stop() noexcept;
+    void reset() noexcept;
+    Sample sample() const noexcept;
+private:
+    std::array<int, EVENT_COUNT> fds;
+    int leader = -1;
+    std::array<uint64_t, EVENT_COUNT> totals{};
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+};
+
+class PerfScope {
+public:
+    explicit PerfScope(PerfCounters& counters) noexcept;
+    PerfScope(const PerfScope& other) = delete;
+    PerfScope& operator=(const PerfScope& other) = delete;
+    ~PerfScope();
+private:
+    PerfCounters& counters;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "perf_counters.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
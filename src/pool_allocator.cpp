@@ -0,0 +1,280 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "pool_allocator.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace detail::pool {
+struct ThreadCache;
+
+struct Header {
+    union {
+        ThreadCache* owner;
+        Header* next;
+    };
+    size_t cls;
+};
+
+static_assert(sizeof(Header) == ::pool::HEADER_SIZE);
+
+struct ThreadCache {
+    Header* lists[::pool::CLASS_COUNT]{};
+    size_t counts[::pool::CLASS_COUNT]{};
+    size_t cached_bytes = 0;
+    std::atomic<Header*> remote{nullptr};
+    ThreadCache* next_orphan = nullptr;
+};
+
+struct Registry {
+    std::mutex lock;
+    ThreadCache* orphans = nullptr;
+};
+
+struct LimitValues {
+    std::atomic<size_t> thread_bytes{::pool::Limits().thread_bytes};
+    std::atomic<size_t> class_bytes{::pool::Limits().class_bytes};
+};
+
+inline auto registry() noexcept -> Registry& {
+    static Registry res;
+    return res;
+}
+
+inline auto limit_values() noexcept -> LimitValues& {
+    static LimitValues res;
+    return res;
+}
+
+inline auto release_cache(ThreadCache* cache) noexcept -> void;
+
+struct CacheHolder {
+    ThreadCache* cache = nullptr;
+    bool exited = false;
+    ~CacheHolder();
+};
+
+inline thread_local ::pool::Stats counters;
+inline thread_local CacheHolder holder;
+
+inline auto block_of(void* ptr) noexcept -> Header* {
+    return static_cast<Header*>(ptr) - 1;
+}
+
+inline auto free_block(Header* block) noexcept -> void {
+    ::operator delete(block);
+}
+
+inline auto cache_block(ThreadCache& cache, Header* block) noexcept -> void {
+    size_t cls = block->cls;
+    size_t bytes = ::pool::class_bytes(cls);
+    LimitValues& limits = limit_values();
+    size_t class_cap = std::max<size_t>(limits.class_bytes.load(std::memory_order_relaxed) / bytes, 1);
+    size_t thread_cap = limits.thread_bytes.load(std::memory_order_relaxed);
+    if (cache.counts[cls] >= class_cap || cache.cached_bytes + bytes > thread_cap) {
+        ++counters.released;
+        free_block(block);
+        return;
+    }
+    block->next = cache.lists[cls];
+    cache.lists[cls] = block;
+    ++cache.counts[cls];
+    cache.cached_bytes += bytes;
+}
+
+inline auto drain_remote(ThreadCache& cache) noexcept -> void {
+    Header* block = cache.remote.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+        Header* next = block->next;
+        ++counters.remote_reclaimed;
+        cache_block(cache, block);
+        block = next;
+    }
+}
+
+inline auto flush(ThreadCache& cache) noexcept -> void {
+    drain_remote(cache);
+    for (size_t cls = 0; cls < ::pool::CLASS_COUNT; ++cls) {
+        while (cache.lists[cls] != nullptr) {
+            Header* next = cache.lists[cls]->next;
+            ++counters.released;
+            free_block(cache.lists[cls]);
+            cache.lists[cls] = next;
+        }
+        cache.counts[cls] = 0;
+    }
+    cache.cached_bytes = 0;
+}
+
+inline auto acquire_cache() noexcept -> ThreadCache* {
+    Registry& reg = registry();
+    {
+        std::lock_guard guard(reg.lock);
+        if (reg.orphans != nullptr)
+            return std::exchange(reg.orphans, reg.orphans->next_orphan);
+    }
+    return new (std::nothrow) ThreadCache();
+}
+
+inline auto release_cache(ThreadCache* cache) noexcept -> void {
+    flush(*cache);
+    Registry& reg = registry();
+    std::lock_guard guard(reg.lock);
+    cache->next_orphan = reg.orphans;
+    reg.orphans = cache;
+}
+
+inline CacheHolder::~CacheHolder() {
+    exited = true;
+    if (cache != nullptr)
+        release_cache(std::exchange(cache, nullptr));
+}
+
+inline auto local_cache() noexcept -> ThreadCache* {
+    if (holder.cache == nullptr && !holder.exited)
+        holder.cache = acquire_cache();
+    return holder.cache;
+}
+}
+
+namespace pool {
+constexpr auto size_class(size_t bytes) noexcept -> size_t {
+    if (bytes > (size_t(1) << MAX_CLASS_SHIFT) - HEADER_SIZE)
+        return CLASS_COUNT;
+    size_t shift = std::bit_width(bytes + HEADER_SIZE - 1);
+    return shift < MIN_CLASS_SHIFT ? 0 : shift - MIN_CLASS_SHIFT;
+}
+
+constexpr auto class_bytes(size_t cls) noexcept -> size_t {
+    return size_t(1) << (cls + MIN_CLASS_SHIFT);
+}
+
+inline auto set_limits(const Limits& limits) noexcept -> void {
+    detail::pool::LimitValues& values = detail::pool::limit_values();
+    values.thread_bytes.store(limits.thread_bytes, std::memory_order_relaxed);
+    values.class_bytes.store(limits.class_bytes, std::memory_order_relaxed);
+}
+
+inline auto limits() noexcept -> Limits {
+    detail::pool::LimitValues& values = detail::pool::limit_values();
+    return {values.thread_bytes.load(std::memory_order_relaxed), values.class_bytes.load(std::memory_order_relaxed)};
+}
+
+inline auto thread_stats() noexcept -> Stats {
+    return detail::pool::counters;
+}
+
+inline auto reset_thread_stats() noexcept -> void {
+    detail::pool::counters = Stats();
+}
+
+inline auto trim() noexcept -> void {
+    if (detail::pool::holder.cache != nullptr)
+        detail::pool::flush(*detail::pool::holder.cache);
+}
+
+inline auto allocate(size_t bytes) -> void* {
+    using detail::pool::Header;
+    Stats& stats = detail::pool::counters;
+    size_t cls = size_class(bytes);
+    detail::pool::ThreadCache* cache = cls == CLASS_COUNT ? nullptr : detail::pool::local_cache();
+    if (cache == nullptr) {
+        auto* block = static_cast<Header*>(::operator new(cls == CLASS_COUNT ? bytes + HEADER_SIZE : class_bytes(cls)));
+        block->owner = nullptr;
+        block->cls = cls;
+        ++stats.large_allocations;
+        return block + 1;
+    }
+    Header* block = cache->lists[cls];
+    if (block == nullptr && cache->remote.load(std::memory_order_relaxed) != nullptr) {
+        detail::pool::drain_remote(*cache);
+        block = cache->lists[cls];
+    }
+    if (block != nullptr) {
+        cache->lists[cls] = block->next;
+        --cache->counts[cls];
+        cache->cached_bytes -= class_bytes(cls);
+        ++stats.hits;
+    } else {
+        block = static_cast<Header*>(::operator new(class_bytes(cls)));
+        ++stats.misses;
+    }
+    block->owner = cache;
+    block->cls = cls;
+    return block + 1;
+}
+
+inline auto deallocate(void* ptr) noexcept -> void {
+    using detail::pool::Header;
+    if (ptr == nullptr)
+        return;
+    Stats& stats = detail::pool::counters;
+    Header* block = detail::pool::block_of(ptr);
+    detail::pool::ThreadCache* owner = block->owner;
+    if (owner == nullptr) {
+        detail::pool::free_block(block);
+    } else if (owner == detail::pool::holder.cache) {
+        ++stats.local_frees;
+        detail::pool::cache_block(*owner, block);
+    } else {
+        ++stats.remote_frees;
+        Header* head = owner->remote.load(std::memory_order_relaxed);
+        do {
+            block->next = head;
+        } while (!owner->remote.compare_exchange_weak(head, block, std::memory_order_release,
+            std::memory_order_relaxed));
+    }
+}
+}
+
+template <class T>
+template <class U>
+constexpr PoolAllocator<T>::PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+template <class T>
+constexpr auto PoolAllocator<T>::allocate(size_t cnt) -> T* {
+    if (std::is_constant_evaluated())
+        return std::allocator<T>().allocate(cnt);
+    if constexpr (POOLED) {
+        if (cnt > SIZE_MAX / sizeof(T))
+            throw std::bad_array_new_length();
+        return static_cast<T*>(pool::allocate(cnt * sizeof(T)));
+    } else {
+        return static_cast<T*>(::operator new(cnt * sizeof(T), std::align_val_t(alignof(T))));
+    }
+}
+
+template <class T>
+constexpr auto PoolAllocator<T>::deallocate(T* ptr, size_t cnt) noexcept -> void {
+    if (std::is_constant_evaluated()) {
+        std::allocator<T>().deallocate(ptr, cnt);
+        return;
+    }
+    if constexpr (POOLED)
+        pool::deallocate(ptr);
+    else
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+}
+
+template <class T>
+constexpr auto PoolAllocator<T>::good_size(size_t cnt) noexcept -> size_t {
+    if (!POOLED || cnt > SIZE_MAX / sizeof(T))
+        return cnt;
+    size_t cls = pool::size_class(cnt * sizeof(T));
+    return cls == pool::CLASS_COUNT ? cnt : (pool::class_bytes(cls) - pool::HEADER_SIZE) / sizeof(T);
+}
+
+template <class T>
+template <class U>
+constexpr auto PoolAllocator<T>::operator==(const PoolAllocator<U>&) const noexcept -> bool {
+    return true;
+}
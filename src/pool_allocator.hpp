@@ -0,0 +1,63 @@
+#ifndef POOL_ALLOCATOR_H
+
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace pool {
+struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t large_allocations = 0;
+    size_t local_frees = 0;
+    size_t remote_frees = 0;
+    size_t remote_reclaimed = 0;
+    size_t released = 0;
+};
+
+struct Limits {
+    size_t thread_bytes = 1 << 22;
+    size_t class_bytes = 1 << 20;
+};
+
+const size_t HEADER_SIZE = 16;
+const size_t MIN_CLASS_SHIFT = 5;
+const size_t MAX_CLASS_SHIFT = 20;
+const size_t CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+
+constexpr size_t size_class(size_t bytes) noexcept;
+constexpr size_t class_bytes(size_t cls) noexcept;
+void set_limits(const Limits& limits) noexcept;
+Limits limits() noexcept;
+Stats thread_stats() noexcept;
+void reset_thread_stats() noexcept;
+void trim() noexcept;
+void* allocate(size_t bytes);
+void deallocate(void* ptr) noexcept;
+}
+
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+    constexpr PoolAllocator() noexcept = default;
+    template <class U>
+    constexpr PoolAllocator(const PoolAllocator<U>& other) noexcept;
+    constexpr T* allocate(size_t cnt);
+    constexpr void deallocate(T* ptr, size_t cnt) noexcept;
+    static constexpr size_t good_size(size_t cnt) noexcept;
+    template <class U>
+    constexpr bool operator==(const PoolAllocator<U>& other) const noexcept;
+private:
+    static const bool POOLED = alignof(T) <= pool::HEADER_SIZE;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "pool_allocator.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "shrink_allocator.hpp"
+#undef IMPL_INCLUDES
+#endif
+
+template <class T, class Base>
+constexpr ShrinkAllocator<T, Base>::ShrinkAllocator(const ShrinkPolicy& policy, const Base& base)
+: Base(base), policy(policy) {}
+
+template <class T, class Base>
+template <class U, class OtherBase>
+constexpr ShrinkAllocator<T, Base>::ShrinkAllocator(const ShrinkAllocator<U, OtherBase>& other)
+: Base(other.base()), policy(other.shrink_policy()) {}
+
+template <class T, class Base>
+constexpr auto ShrinkAllocator<T, Base>::shrink_policy() const noexcept -> const ShrinkPolicy& {
+    return policy;
+}
+
+template <class T, class Base>
+constexpr auto ShrinkAllocator<T, Base>::base() const noexcept -> const Base& {
+    return *this;
+}
+
+template <class T, class Base>
+template <class U, class OtherBase>
+constexpr auto ShrinkAllocator<T, Base>::operator==(const ShrinkAllocator<U, OtherBase>& other) const noexcept -> bool {
+    return base() == other.base();
+}
@@ -0,0 +1,41 @@
+#ifndef SHRINK_ALLOCATOR_H
+
+#define SHRINK_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+
+struct ShrinkPolicy {
+    size_t low_water_ratio = 4;
+    size_t idle_ops = 1024;
+    size_t headroom = 2;
+    size_t min_capacity = 64;
+};
+
+template <class T, class Base = std::allocator<T>>
+class ShrinkAllocator: public Base {
+public:
+    using value_type = T;
+    template <class U>
+    struct rebind {
+        using other = ShrinkAllocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+    };
+    constexpr ShrinkAllocator() = default;
+    explicit constexpr ShrinkAllocator(const ShrinkPolicy& policy, const Base& base = Base());
+    template <class U, class OtherBase>
+    constexpr ShrinkAllocator(const ShrinkAllocator<U, OtherBase>& other);
+    constexpr const ShrinkPolicy& shrink_policy() const noexcept;
+    constexpr const Base& base() const noexcept;
+    template <class U, class OtherBase>
+    constexpr bool operator==(const ShrinkAllocator<U, OtherBase>& other) const noexcept;
+private:
+    ShrinkPolicy policy;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "shrink_allocator.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,546 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "soa_vector.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+constexpr auto align_up(size_t val, size_t align) noexcept -> size_t {
+    return (val + align - 1) / align * align;
+}
+}
+
+template <class... Ts>
+template <class F>
+constexpr auto SoaVector<Ts...>::for_each_column(F&& func) -> void {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (func(std::integral_constant<size_t, I>()), ...);
+    }(std::index_sequence_for<Ts...>());
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::buffer_size(size_t cap) noexcept -> size_t {
+    return (detail::align_up(cap * sizeof(Ts), COLUMN_ALIGN) + ... + 0);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::allocate_buffer(size_t cap) -> std::byte* {
+    static_assert(((alignof(Ts) <= COLUMN_ALIGN) && ...));
+    if (cap == 0)
+        return nullptr;
+    if (cap > (SIZE_MAX - sizeof...(Ts) * COLUMN_ALIGN) / (sizeof(Ts) + ... + 0))
+        throw std::bad_array_new_length();
+    return static_cast<std::byte*>(::operator new(buffer_size(cap), std::align_val_t(COLUMN_ALIGN)));
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::deallocate_buffer(std::byte* buf, size_t cap) noexcept -> void {
+    if (buf == nullptr)
+        return;
+    ::operator delete(buf, buffer_size(cap), std::align_val_t(COLUMN_ALIGN));
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::columns_at(std::byte* buf, size_t cap) noexcept -> Columns {
+    if (buf == nullptr)
+        return Columns();
+    size_t offset = 0;
+    auto place = [&]<class T>(T*) -> T* {
+        T* col = reinterpret_cast<T*>(buf + offset);
+        offset += detail::align_up(cap * sizeof(T), COLUMN_ALIGN);
+        return col;
+    };
+    return Columns{place(static_cast<Ts*>(nullptr))...};
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::destroy_rows(const Columns& cols, size_t first, size_t last, size_t col_cnt) noexcept
+-> void {
+    for_each_column([&](auto col) {
+        if (col() < col_cnt)
+            std::destroy(std::get<col()>(cols) + first, std::get<col()>(cols) + last);
+    });
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::grown_capacity(size_t min_cap) const noexcept -> size_t {
+    size_t new_cap = cap ? cap : INITIAL_CAP;
+    while (min_cap > new_cap)
+        new_cap *= GROWTH_RATE;
+    return new_cap;
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::relocate_to(std::byte* new_buf, size_t new_cap) -> void {
+    Columns new_cols = columns_at(new_buf, new_cap);
+    std::array<bool, sizeof...(Ts)> built{};
+    try {
+        for (bool copying : {true, false}) {
+            for_each_column([&](auto col) {
+                using T = column_type<col()>;
+                constexpr bool COPY = COPY_ROWS && std::is_copy_constructible_v<T>;
+                if (COPY != copying)
+                    return;
+                if constexpr (COPY)
+                    std::uninitialized_copy_n(std::get<col()>(cols), sz, std::get<col()>(new_cols));
+                else
+                    std::uninitialized_move_n(std::get<col()>(cols), sz, std::get<col()>(new_cols));
+                built[col()] = true;
+            });
+        }
+    } catch(...) {
+        for_each_column([&](auto col) {
+            if (built[col()])
+                std::destroy_n(std::get<col()>(new_cols), sz);
+        });
+        throw;
+    }
+    destroy_rows(cols, 0, sz, sizeof...(Ts));
+    deallocate_buffer(buf, cap);
+    buf = new_buf;
+    cols = new_cols;
+    cap = new_cap;
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::reallocate(size_t new_cap) -> void {
+    std::byte* new_buf = allocate_buffer(new_cap);
+    try {
+        relocate_to(new_buf, new_cap);
+    } catch(...) {
+        deallocate_buffer(new_buf, new_cap);
+        throw;
+    }
+}
+
+template <class... Ts>
+template <class... Args>
+auto SoaVector<Ts...>::reallocate_append(Args&&... args) -> void {
+    size_t new_cap = grown_capacity(sz + 1);
+    std::byte* new_buf = allocate_buffer(new_cap);
+    Columns new_cols = columns_at(new_buf, new_cap);
+    try {
+        construct_row(new_cols, sz, std::forward<Args>(args)...);
+    } catch(...) {
+        deallocate_buffer(new_buf, new_cap);
+        throw;
+    }
+    try {
+        relocate_to(new_buf, new_cap);
+    } catch(...) {
+        destroy_rows(new_cols, sz, sz + 1, sizeof...(Ts));
+        deallocate_buffer(new_buf, new_cap);
+        throw;
+    }
+}
+
+template <class... Ts>
+template <class... Args>
+auto SoaVector<Ts...>::construct_row(const Columns& cols, size_t idx, Args&&... args) -> void {
+    static_assert(sizeof...(Args) == sizeof...(Ts) || sizeof...(Args) == 0);
+    std::tuple<Args&&...> fwd(std::forward<Args>(args)...);
+    size_t done = 0;
+    try {
+        for_each_column([&](auto col) {
+            auto* place = std::get<col()>(cols) + idx;
+            if constexpr (sizeof...(Args) == 0)
+                std::construct_at(place);
+            else
+                std::construct_at(place, std::get<col()>(std::move(fwd)));
+            ++done;
+        });
+    } catch(...) {
+        destroy_rows(cols, idx, idx + 1, done);
+        throw;
+    }
+}
+
+template <class... Ts>
+SoaVector<Ts...>::SoaVector(size_t sz) {
+    resize(sz);
+}
+
+template <class... Ts>
+SoaVector<Ts...>::SoaVector(size_t sz, const Ts&... vals) {
+    resize(sz, vals...);
+}
+
+template <class... Ts>
+SoaVector<Ts...>::SoaVector(const SoaVector& other)
+: cap(other.sz), buf(allocate_buffer(cap)), cols(columns_at(buf, cap)) {
+    size_t done = 0;
+    try {
+        for_each_column([&](auto col) {
+            std::uninitialized_copy_n(std::get<col()>(other.cols), other.sz, std::get<col()>(cols));
+            ++done;
+        });
+    } catch(...) {
+        destroy_rows(cols, 0, other.sz, done);
+        deallocate_buffer(buf, cap);
+        throw;
+    }
+    sz = other.sz;
+}
+
+template <class... Ts>
+constexpr SoaVector<Ts...>::SoaVector(SoaVector&& other) noexcept {
+    swap(other);
+}
+
+template <class... Ts>
+SoaVector<Ts...>::~SoaVector() {
+    destroy_rows(cols, 0, sz, sizeof...(Ts));
+    deallocate_buffer(buf, cap);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::operator=(const SoaVector& other) & -> SoaVector& {
+    SoaVector copy(other);
+    swap(copy);
+    return *this;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::operator=(SoaVector&& other) & noexcept -> SoaVector& {
+    SoaVector empty;
+    swap(other);
+    other.swap(empty);
+    return *this;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::swap(SoaVector& other) & noexcept -> void {
+    std::swap(sz, other.sz);
+    std::swap(cap, other.cap);
+    std::swap(buf, other.buf);
+    std::swap(cols, other.cols);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::size() const noexcept -> size_t {
+    return sz;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::empty() const noexcept -> bool {
+    return sz == 0;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::capacity() const noexcept -> size_t {
+    return cap;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::operator[](size_t idx) noexcept -> reference {
+    return std::apply([idx](Ts*... col) { return reference(col[idx]...); }, cols);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::operator[](size_t idx) const noexcept -> const_reference {
+    return std::apply([idx](Ts*... col) { return const_reference(col[idx]...); }, cols);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::at(size_t idx) -> reference {
+    if (idx >= sz)
+        throw std::out_of_range("SoaVector::at");
+    return (*this)[idx];
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::at(size_t idx) const -> const_reference {
+    if (idx >= sz)
+        throw std::out_of_range("SoaVector::at");
+    return (*this)[idx];
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::front() noexcept -> reference {
+    return (*this)[0];
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::front() const noexcept -> const_reference {
+    return (*this)[0];
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::back() noexcept -> reference {
+    return (*this)[sz - 1];
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::back() const noexcept -> const_reference {
+    return (*this)[sz - 1];
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::get(size_t idx) noexcept -> column_type<I>& {
+    return std::get<I>(cols)[idx];
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::get(size_t idx) const noexcept -> const column_type<I>& {
+    return std::get<I>(cols)[idx];
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::data() noexcept -> column_type<I>* {
+    return std::get<I>(cols);
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::data() const noexcept -> const column_type<I>* {
+    return std::get<I>(cols);
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::column() noexcept -> std::span<column_type<I>> {
+    return {std::get<I>(cols), sz};
+}
+
+template <class... Ts>
+template <size_t I>
+constexpr auto SoaVector<Ts...>::column() const noexcept -> std::span<const column_type<I>> {
+    return {std::get<I>(cols), sz};
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::reserve(size_t new_cap) -> void {
+    if (new_cap <= cap)
+        return;
+    reallocate(grown_capacity(new_cap));
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::shrink_to_fit() -> void {
+    if (sz == cap)
+        return;
+    reallocate(sz);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::resize(size_t new_sz) -> void {
+    if (new_sz <= sz) {
+        destroy_rows(cols, new_sz, sz, sizeof...(Ts));
+        sz = new_sz;
+        return;
+    }
+    reserve(new_sz);
+    for (; sz < new_sz; ++sz)
+        construct_row(cols, sz);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::resize(size_t new_sz, const Ts&... vals) -> void {
+    if (new_sz <= sz) {
+        destroy_rows(cols, new_sz, sz, sizeof...(Ts));
+        sz = new_sz;
+        return;
+    }
+    auto fill = [&](const Ts&... row) {
+        for (; sz < new_sz; ++sz)
+            construct_row(cols, sz, row...);
+    };
+    if (new_sz <= cap) {
+        fill(vals...);
+        return;
+    }
+    std::tuple<Ts...> copy(vals...);
+    reserve(new_sz);
+    std::apply(fill, copy);
+}
+
+template <class... Ts>
+template <class... Args>
+auto SoaVector<Ts...>::emplace_back(Args&&... args) -> reference {
+    if (sz == cap)
+        reallocate_append(std::forward<Args>(args)...);
+    else
+        construct_row(cols, sz, std::forward<Args>(args)...);
+    ++sz;
+    return back();
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::push_back(const Ts&... vals) -> void {
+    emplace_back(vals...);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::push_back(Ts&&... vals) -> void {
+    emplace_back(std::move(vals)...);
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::pop_back() -> void {
+    destroy_rows(cols, sz - 1, sz, sizeof...(Ts));
+    --sz;
+}
+
+template <class... Ts>
+auto SoaVector<Ts...>::clear() noexcept -> void {
+    destroy_rows(cols, 0, sz, sizeof...(Ts));
+    sz = 0;
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::begin() noexcept -> iterator {
+    return iterator(this, 0);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::begin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::cbegin() const noexcept -> const_iterator {
+    return const_iterator(this, 0);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::end() noexcept -> iterator {
+    return iterator(this, sz);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::end() const noexcept -> const_iterator {
+    return const_iterator(this, sz);
+}
+
+template <class... Ts>
+constexpr auto SoaVector<Ts...>::cend() const noexcept -> const_iterator {
+    return const_iterator(this, sz);
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr SoaVector<Ts...>::RowIterator<Const>::RowIterator(Owner* owner, size_t idx) noexcept
+: owner(owner), idx(idx) {}
+
+template <class... Ts>
+template <bool Const>
+constexpr SoaVector<Ts...>::RowIterator<Const>::operator RowIterator<true>() const noexcept {
+    return RowIterator<true>(owner, idx);
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator*() const noexcept -> reference {
+    return (*owner)[idx];
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator[](difference_type idx) const noexcept
+-> reference {
+    return (*owner)[this->idx + idx];
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator+=(difference_type idx) noexcept
+-> RowIterator& {
+    this->idx += idx;
+    return *this;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator-=(difference_type idx) noexcept
+-> RowIterator& {
+    this->idx -= idx;
+    return *this;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator++() noexcept -> RowIterator& {
+    return *this += 1;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator++(int) noexcept -> RowIterator {
+    RowIterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator--() noexcept -> RowIterator& {
+    return *this -= 1;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator--(int) noexcept -> RowIterator {
+    RowIterator copy = *this;
+    --*this;
+    return copy;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator+(difference_type idx) const noexcept
+-> RowIterator {
+    RowIterator copy = *this;
+    copy += idx;
+    return copy;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator-(difference_type idx) const noexcept
+-> RowIterator {
+    RowIterator copy = *this;
+    copy -= idx;
+    return copy;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator-(const RowIterator& other) const noexcept
+-> difference_type {
+    return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx);
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator==(const RowIterator& other) const noexcept
+-> bool {
+    return idx == other.idx;
+}
+
+template <class... Ts>
+template <bool Const>
+constexpr auto SoaVector<Ts...>::RowIterator<Const>::operator<=>(const RowIterator& other) const noexcept
+-> std::strong_ordering {
+    return idx <=> other.idx;
+}
+
+namespace std {
+    template <class... Ts>
+    constexpr auto swap(SoaVector<Ts...>& lhs, SoaVector<Ts...>& rhs) noexcept -> void {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef SOA_VECTOR_H
+
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <compare>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+template <class... Ts>
+class SoaVector {
+private:
+    template <bool Const>
+    class RowIterator;
+public:
+    using value_type = std::tuple<Ts...>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, value_type>;
+    static const size_t COLUMN_ALIGN = 64;
+    constexpr SoaVector() noexcept = default;
+    explicit SoaVector(size_t sz);
+    SoaVector(size_t sz, const Ts&... vals);
+    SoaVector(const SoaVector& other);
+    constexpr SoaVector(SoaVector&& other) noexcept;
+    ~SoaVector();
+    SoaVector& operator=(const SoaVector& other) &;
+    constexpr SoaVector& operator=(SoaVector&& other) & noexcept;
+    constexpr void swap(SoaVector& other) & noexcept;
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr size_t capacity() const noexcept;
+    constexpr reference operator[](size_t idx) noexcept;
+    constexpr const_reference operator[](size_t idx) const noexcept;
+    reference at(size_t idx);
+    const_reference at(size_t idx) const;
+    constexpr reference front() noexcept;
+    constexpr const_reference front() const noexcept;
+    constexpr reference back() noexcept;
+    constexpr const_reference back() const noexcept;
+    template <size_t I>
+    constexpr column_type<I>& get(size_t idx) noexcept;
+    template <size_t I>
+    constexpr const column_type<I>& get(size_t idx) const noexcept;
+    template <size_t I>
+    constexpr column_type<I>* data() noexcept;
+    template <size_t I>
+    constexpr const column_type<I>* data() const noexcept;
+    template <size_t I>
+    constexpr std::span<column_type<I>> column() noexcept;
+    template <size_t I>
+    constexpr std::span<const column_type<I>> column() const noexcept;
+    void reserve(size_t new_cap);
+    void shrink_to_fit();
+    void resize(size_t new_sz);
+    void resize(size_t new_sz, const Ts&... vals);
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    void push_back(const Ts&... vals);
+    void push_back(Ts&&... vals);
+    void pop_back();
+    void clear() noexcept;
+    constexpr iterator begin() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+private:
+    using Columns = std::tuple<Ts*...>;
+    static const size_t INITIAL_CAP = 4;
+    static const size_t GROWTH_RATE = 2;
+    static constexpr bool COPY_ROWS = !((std::is_nothrow_move_constructible_v<Ts> || !std::is_copy_constructible_v<Ts>)
+        && ...);
+    static size_t buffer_size(size_t cap) noexcept;
+    static std::byte* allocate_buffer(size_t cap);
+    static void deallocate_buffer(std::byte* buf, size_t cap) noexcept;
+    static Columns columns_at(std::byte* buf, size_t cap) noexcept;
+    static void destroy_rows(const Columns& cols, size_t first, size_t last, size_t col_cnt) noexcept;
+    template <class F>
+    static constexpr void for_each_column(F&& func);
+    size_t grown_capacity(size_t min_cap) const noexcept;
+    void relocate_to(std::byte* new_buf, size_t new_cap);
+    void reallocate(size_t new_cap);
+    template <class... Args>
+    void reallocate_append(Args&&... args);
+    template <class... Args>
+    static void construct_row(const Columns& cols, size_t idx, Args&&... args);
+    size_t sz = 0;
+    size_t cap = 0;
+    std::byte* buf = nullptr;
+    Columns cols{};
+};
+
+template <class... Ts>
+template <bool Const>
+class SoaVector<Ts...>::RowIterator {
+public:
+    using difference_type = ptrdiff_t;
+    using value_type = std::tuple<Ts...>;
+    using reference = std::conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+    using Owner = std::conditional_t<Const, const SoaVector, SoaVector>;
+    constexpr RowIterator() noexcept = default;
+    constexpr RowIterator(Owner* owner, size_t idx) noexcept;
+    constexpr operator RowIterator<true>() const noexcept;
+    constexpr reference operator*() const noexcept;
+    constexpr reference operator[](difference_type idx) const noexcept;
+    constexpr RowIterator& operator+=(difference_type idx) noexcept;
+    constexpr RowIterator& operator-=(difference_type idx) noexcept;
+    constexpr RowIterator& operator++() noexcept;
+    constexpr RowIterator operator++(int) noexcept;
+    constexpr RowIterator& operator--() noexcept;
+    constexpr RowIterator operator--(int) noexcept;
+    constexpr RowIterator operator+(difference_type idx) const noexcept;
+    constexpr RowIterator operator-(difference_type idx) const noexcept;
+    constexpr difference_type operator-(const RowIterator& other) const noexcept;
+    constexpr bool operator==(const RowIterator& other) const noexcept;
+    constexpr std::strong_ordering operator<=>(const RowIterator& other) const noexcept;
+private:
+    Owner* owner = nullptr;
+    size_t idx = 0;
+};
+
+namespace std {
+    template <class... Ts>
+    constexpr void swap(SoaVector<Ts...>& lhs, SoaVector<Ts...>& rhs) noexcept;
+}
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "soa_vector.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "thread_pool.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace detail::thread_pool {
+struct Worker {
+    const ::ThreadPool* pool = nullptr;
+    size_t queue = 0;
+};
+
+inline thread_local Worker current;
+}
+
+inline ThreadPool::ThreadPool(size_t threads)
+: thread_cnt(std::max<size_t>(threads, 1)), queues(new Queue[thread_cnt]) {
+    try {
+        workers.reserve(thread_cnt - 1);
+        for (size_t idx = 1; idx < thread_cnt; ++idx)
+            workers.emplace_back([this, idx] { worker_loop(idx); });
+    } catch(...) {
+        stop();
+        throw;
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    stop();
+}
+
+inline auto ThreadPool::stop() noexcept -> void {
+    {
+        std::lock_guard guard(sleep_lock);
+        stopping.store(true, std::memory_order_relaxed);
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+inline auto ThreadPool::size() const noexcept -> size_t {
+    return thread_cnt;
+}
+
+inline auto ThreadPool::shared() -> ThreadPool& {
+    static ThreadPool res;
+    return res;
+}
+
+inline auto ThreadPool::local_queue() const noexcept -> size_t {
+    return detail::thread_pool::current.pool == this ? detail::thread_pool::current.queue : 0;
+}
+
+inline auto ThreadPool::push(Task task) -> void {
+    Queue& queue = queues[local_queue()];
+    {
+        std::lock_guard guard(queue.lock);
+        queue.tasks.push_back(task);
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard guard(sleep_lock);
+    }
+    wake.notify_one();
+}
+
+inline auto ThreadPool::try_run_one() -> bool {
+    size_t own = local_queue();
+    for (size_t i = 0; i < thread_cnt; ++i) {
+        Queue& queue = queues[(own + i) % thread_cnt];
+        Task task;
+        {
+            std::lock_guard guard(queue.lock);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task.run(task.arg);
+        return true;
+    }
+    return false;
+}
+
+inline auto ThreadPool::wait_for(const std::atomic<bool>& done) -> void {
+    while (!done.load(std::memory_order_acquire)) {
+        if (!try_run_one())
+            std::this_thread::yield();
+    }
+}
+
+inline auto ThreadPool::worker_loop(size_t idx) -> void {
+    detail::thread_pool::current = {this, idx};
+    while (true) {
+        if (try_run_one())
+            continue;
+        std::unique_lock guard(sleep_lock);
+        wake.wait(guard, [this] {
+            return stopping.load(std::memory_order_relaxed) || queued.load(std::memory_order_acquire) != 0;
+        });
+        if (stopping.load(std::memory_order_relaxed) && queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+template <class F, class G>
+auto ThreadPool::fork_join(F&& left, G&& right) -> void {
+    if (thread_cnt == 1) {
+        left();
+        right();
+        return;
+    }
+    struct Job {
+        std::remove_reference_t<G>* body;
+        std::exception_ptr error;
+        std::atomic<bool> done{false};
+    };
+    Job job{&right, nullptr};
+    push({[] (void* arg) {
+        Job& forked = *static_cast<Job*>(arg);
+        try {
+            (*forked.body)();
+        } catch(...) {
+            forked.error = std::current_exception();
+        }
+        forked.done.store(true, std::memory_order_release);
+    }, &job});
+    std::exception_ptr error;
+    try {
+        left();
+    } catch(...) {
+        error = std::current_exception();
+    }
+    wait_for(job.done);
+    if (error)
+        std::rethrow_exception(error);
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+template <class F>
+auto ThreadPool::parallel_for(size_t first, size_t last, size_t grain, F&& body) -> void {
+    grain = std::max<size_t>(grain, 1);
+    if (last - first <= grain || thread_cnt == 1) {
+        if (first < last)
+            body(first, last);
+        return;
+    }
+    size_t mid = first + (last - first) / 2;
+    fork_join([&] { parallel_for(first, mid, grain, body); }, [&] { parallel_for(mid, last, grain, body); });
+}
@@ -0,0 +1,56 @@
+#ifndef THREAD_POOL_H
+
+#define THREAD_POOL_H
+
+#include "vector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+    size_t size() const noexcept;
+    template <class F, class G>
+    void fork_join(F&& left, G&& right);
+    template <class F>
+    void parallel_for(size_t first, size_t last, size_t grain, F&& body);
+    static ThreadPool& shared();
+private:
+    struct Task {
+        void (*run)(void*) = nullptr;
+        void* arg = nullptr;
+    };
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+    size_t local_queue() const noexcept;
+    void push(Task task);
+    bool try_run_one();
+    void wait_for(const std::atomic<bool>& done);
+    void worker_loop(size_t idx);
+    void stop() noexcept;
+    size_t thread_cnt;
+    std::unique_ptr<Queue[]> queues;
+    Vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+};
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "thread_pool.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif
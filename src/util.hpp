@@ -0,0 +1,80 @@
+#ifndef UTIL_H
+
+#define UTIL_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+const size_t INITIAL_CAP = 1;
+const size_t GROWTH_RATE = 2;
+const size_t OUT_OF_RANGE_MSG_SIZE = 128;
+const char* const OUT_OF_RANGE_MSG = "at: idx (which is %zu) >= this->size() (which is %zu)";
+const char* const LENGTH_ERROR_MSG = "Vector: requested size exceeds max_size()";
+const char* const UNSORTED_INDICES_MSG = "erase_indices: indices are not in ascending order";
+
+template <class T>
+inline constexpr bool is_zero_value_initialized_v = std::is_scalar_v<T> && !std::is_member_pointer_v<T>;
+
+template <class Alloc, class T, class... Args>
+concept AllocatorConstructs = requires (Alloc& alloc, T* ptr, Args&&... args) {
+    alloc.construct(ptr, std::forward<Args>(args)...);
+};
+
+template <class Alloc, class T>
+concept AllocatorZeroes = requires (Alloc& alloc, size_t cnt) {
+    { alloc.allocate_zeroed(cnt) } -> std::same_as<T*>;
+};
+
+template <class R, class T>
+concept ContainerCompatibleRange = std::ranges::input_range<R>
+    && std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+template <class Alloc>
+concept ShrinkingAllocator = requires (const Alloc& alloc) {
+    alloc.shrink_policy();
+};
+
+template <class Alloc, class T>
+concept AllocatorShrinks = requires (Alloc& alloc, T* ptr, size_t cnt) {
+    { alloc.shrink_in_place(ptr, cnt, cnt) } -> std::same_as<bool>;
+};
+
+template <class Alloc>
+concept SizeClassAllocator = requires (const Alloc& alloc, size_t cnt) {
+    { alloc.good_size(cnt) } -> std::same_as<size_t>;
+};
+
+template <bool Enabled>
+struct ShrinkState {};
+
+template <>
+struct ShrinkState<true> {
+    size_t idle_ops = 0;
+};
+
+template <class Alloc, class T>
+concept PaddedAllocator = std::is_trivially_copyable_v<T> && requires {
+    { Alloc::alignment } -> std::convertible_to<size_t>;
+} && Alloc::alignment % sizeof(T) == 0;
+
+template <class Alloc, class T>
+inline constexpr bool can_zero_fill_v = is_zero_value_initialized_v<T> && !AllocatorConstructs<Alloc, T>;
+
+template <class Alloc, class T>
+inline constexpr bool can_broadcast_fill_v = std::is_trivially_copy_constructible_v<T>
+    && std::is_trivially_destructible_v<T> && !AllocatorConstructs<Alloc, T, const T&>;
+
+[[noreturn]] inline auto throw_out_of_range(size_t idx, size_t sz) -> void {
+    char buf[OUT_OF_RANGE_MSG_SIZE];
+    snprintf(buf, sizeof(buf), OUT_OF_RANGE_MSG, idx, sz);
+    throw std::out_of_range(buf);
+}
+}
+
+#endif
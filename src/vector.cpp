@@ -4,15 +4,26 @@
 #undef IMPL_INCLUDES
 #endif
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <compare>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VECTOR_HAS_X86_COMPRESS
+#endif
 
 namespace detail {
 template <class Alloc>
@@ -21,6 +32,13 @@ constexpr auto copy_allocator(const Alloc& alloc) -> Alloc {
     return AllocTraits::select_on_container_copy_construction(alloc);
 }
 
+template <class T, class Alloc>
+constexpr auto destroy(Alloc& alloc, T* first, T* last) -> void {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    for (; first != last; ++first)
+        AllocTraits::destroy(alloc, first);
+}
+
 template <class T, class Alloc>
 constexpr auto destroy_before(Alloc& alloc, T* buf, size_t cap, size_t i) -> void {
     using AllocTraits = std::allocator_traits<Alloc>;
@@ -32,554 +50,945 @@ constexpr auto destroy_before(Alloc& alloc, T* buf, size_t cap, size_t i) -> voi
             break;
         }
     }
+    if (buf == nullptr)
+        return;
     try {
         AllocTraits::deallocate(alloc, buf, cap);
     } catch(...) {}
 }
 
+template <class T, class Alloc, class InputIt>
+constexpr auto uninitialized_copy(Alloc& alloc, InputIt first, size_t cnt, T* dest) -> T* {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    if constexpr (std::contiguous_iterator<InputIt> && std::is_same_v<std::iter_value_t<InputIt>, T>
+        && std::is_trivially_copyable_v<T> && !detail::AllocatorConstructs<Alloc, T, std::iter_reference_t<InputIt>>) {
+        if (!std::is_constant_evaluated()) {
+            if (cnt != 0)
+                std::memcpy(static_cast<void*>(dest), std::to_address(first), cnt * sizeof(T));
+            return dest + cnt;
+        }
+    }
+    for (size_t i = 0; i < cnt; ++i, ++first) {
+        try {
+            AllocTraits::construct(alloc, dest + i, *first);
+        } catch(...) {
+            detail::destroy(alloc, dest, dest + i);
+            throw;
+        }
+    }
+    return dest + cnt;
+}
+
 template <class T, class Alloc>
-constexpr auto reserve_strict(Alloc& alloc, T*& ptr, size_t sz, size_t& cap, size_t new_cap) -> void {
+constexpr auto uninitialized_fill(Alloc& alloc, T* dest, size_t cnt, const T& val) -> T* {
     using AllocTraits = std::allocator_traits<Alloc>;
-    T* buf = AllocTraits::allocate(alloc, new_cap);
-    for (size_t i = 0; i < sz; ++i) {
+    if constexpr (detail::can_broadcast_fill_v<Alloc, T>) {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_fill_n(dest, cnt, val);
+    }
+    for (size_t i = 0; i < cnt; ++i) {
         try {
-            AllocTraits::construct(alloc, buf + i, ptr[i]);
+            AllocTraits::construct(alloc, dest + i, val);
         } catch(...) {
-            detail::destroy_before(alloc, buf, new_cap, i);
+            detail::destroy(alloc, dest, dest + i);
             throw;
         }
     }
+    return dest + cnt;
+}
+
+template <class T, class Alloc>
+constexpr auto uninitialized_value_construct(Alloc& alloc, T* dest, size_t cnt) -> T* {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    if constexpr (detail::can_zero_fill_v<Alloc, T>) {
+        if (!std::is_constant_evaluated()) {
+            if (cnt != 0)
+                std::memset(static_cast<void*>(dest), 0, cnt * sizeof(T));
+            return dest + cnt;
+        }
+    } else if constexpr (std::is_trivially_default_constructible_v<T> && detail::can_broadcast_fill_v<Alloc, T>) {
+        if (!std::is_constant_evaluated())
+            return std::uninitialized_fill_n(dest, cnt, T());
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        try {
+            AllocTraits::construct(alloc, dest + i);
+        } catch(...) {
+            detail::destroy(alloc, dest, dest + i);
+            throw;
+        }
+    }
+    return dest + cnt;
+}
+
+template <class T, class Alloc>
+auto allocate_zeroed(Alloc& alloc, size_t cnt) -> T* {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    if constexpr (detail::AllocatorZeroes<Alloc, T>)
+        return alloc.allocate_zeroed(cnt);
+    T* buf = AllocTraits::allocate(alloc, cnt);
+    if (cnt != 0)
+        std::memset(static_cast<void*>(buf), 0, cnt * sizeof(T));
+    return buf;
+}
+
+template <class T, class Alloc>
+constexpr auto uninitialized_relocate(Alloc& alloc, T* first, T* last, T* dest) -> T* {
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+        return detail::uninitialized_copy(alloc, std::make_move_iterator(first), last - first, dest);
+    else
+        return detail::uninitialized_copy(alloc, first, last - first, dest);
+}
+
+template <class Size>
+constexpr auto checked_size(size_t cnt) -> size_t {
+    if constexpr (sizeof(Size) < sizeof(size_t)) {
+        if (cnt > std::numeric_limits<Size>::max())
+            throw std::length_error(LENGTH_ERROR_MSG);
+    }
+    return cnt;
+}
+
+template <class Alloc, class T>
+constexpr auto zero_padding(T* ptr, size_t sz) noexcept -> void {
+    if constexpr (PaddedAllocator<Alloc, T>) {
+        if (std::is_constant_evaluated())
+            return;
+        const size_t lanes = Alloc::alignment / sizeof(T);
+        size_t padded_sz = (sz + lanes - 1) / lanes * lanes;
+        if (padded_sz != sz)
+            std::memset(static_cast<void*>(ptr + sz), 0, (padded_sz - sz) * sizeof(T));
+    }
+}
+
+template <class T>
+auto compress_scalar(const T* src, uint64_t keep, size_t cnt, T* dst) noexcept -> size_t {
+    size_t write = 0;
+    for (size_t i = 0; i < cnt; ++i) {
+        dst[write] = src[i];
+        write += (keep >> i) & 1;
+    }
+    return write;
+}
+
+#ifdef VECTOR_HAS_X86_COMPRESS
+inline auto has_simd_compress() noexcept -> bool {
+    static const bool res = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+    return res;
+}
+
+__attribute__((target("avx2,bmi2")))
+inline auto compress_lanes(const std::byte* src, uint64_t lane_mask, std::byte* dst) noexcept -> void {
+    uint64_t spread = _pdep_u64(lane_mask, 0x0101010101010101) * 0xFF;
+    uint64_t order = _pext_u64(0x0706050403020100, spread);
+    __m256i perm = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(order)));
+    __m256i vals = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permutevar8x32_epi32(vals, perm));
+}
+
+__attribute__((target("avx2,bmi2")))
+inline auto compress_words(const std::byte* src, uint64_t keep, size_t cnt, size_t elem_size, std::byte* dst) noexcept
+-> size_t {
+    const size_t LANE_BYTES = 32;
+    size_t chunk = LANE_BYTES / elem_size;
+    size_t write = 0;
+    for (size_t i = 0; i < cnt; i += chunk) {
+        uint64_t bits = (keep >> i) & ((uint64_t(1) << chunk) - 1);
+        uint64_t lane_mask = elem_size == 4 ? bits : _pdep_u64(bits, 0x55) * 3;
+        compress_lanes(src + i * elem_size, lane_mask, dst + write * elem_size);
+        write += std::popcount(bits);
+    }
+    return write;
+}
+#endif
+
+template <class T>
+auto compress(const T* src, uint64_t keep, size_t cnt, T* dst) noexcept -> size_t {
+#ifdef VECTOR_HAS_X86_COMPRESS
+    if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+        if (has_simd_compress()) {
+            size_t full = cnt / (32 / sizeof(T)) * (32 / sizeof(T));
+            size_t write = compress_words(reinterpret_cast<const std::byte*>(src), keep, full, sizeof(T),
+                reinterpret_cast<std::byte*>(dst));
+            if (full == cnt)
+                return write;
+            return write + compress_scalar(src + full, keep >> full, cnt - full, dst + write);
+        }
+    }
+#endif
+    return compress_scalar(src, keep, cnt, dst);
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto reserve_strict(Alloc& alloc, T*& ptr, size_t sz, Size& cap, size_t new_cap) -> void {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    detail::checked_size<Size>(new_cap);
+    T* buf = AllocTraits::allocate(alloc, new_cap);
+    detail::stats::allocated<T>(new_cap, ptr != nullptr);
     try {
-        AllocTraits::deallocate(alloc, ptr, cap);
+        detail::uninitialized_relocate(alloc, ptr, ptr + sz, buf);
     } catch(...) {
-        detail::destroy_before(alloc, buf, new_cap, sz);
+        AllocTraits::deallocate(alloc, buf, new_cap);
         throw;
     }
+    detail::stats::relocated<T>(sz);
+    detail::destroy(alloc, ptr, ptr + sz);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, cap);
     ptr = buf;
     cap = new_cap;
+    detail::zero_padding<Alloc>(ptr, sz);
 }
 }
 
-template <class T, class Alloc>
-template <class InputIt>
-constexpr Vector<T, Alloc>::Vector(InputIt first, InputIt last, const Alloc& alloc, bool copy)
-: Vector::FinalHelper(alloc),
-sz(std::distance(first, last) * copy),
-cap(sz * copy),
-ptr(AllocTraits::allocate(static_cast<Alloc&>(*this), cap)) {
-    if (!copy) 
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::allocator() noexcept -> Alloc& {
+    return *this;
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::grown_capacity(size_t min_cap) const -> size_t {
+    size_t new_cap = cap ? cap : detail::INITIAL_CAP;
+    while (min_cap > new_cap)
+        new_cap *= detail::GROWTH_RATE;
+    if constexpr (detail::SizeClassAllocator<Alloc>)
+        new_cap = static_cast<const Alloc&>(*this).good_size(new_cap);
+    new_cap = std::min(new_cap, max_size());
+    return detail::checked_size<Size>(std::max(new_cap, min_cap));
+}
+
+template <class T, class Alloc, class Size>
+template <class F>
+constexpr auto Vector<T, Alloc, Size>::reallocate_insert(size_t idx, size_t cnt, F&& construct) -> T* {
+    size_t new_cap = grown_capacity(sz + cnt);
+    T* buf = AllocTraits::allocate(allocator(), new_cap);
+    detail::stats::allocated<T>(new_cap, ptr != nullptr);
+    try {
+        construct(buf + idx);
+    } catch(...) {
+        AllocTraits::deallocate(allocator(), buf, new_cap);
+        throw;
+    }
+    try {
+        detail::uninitialized_relocate(allocator(), ptr, ptr + idx, buf);
+    } catch(...) {
+        detail::destroy(allocator(), buf + idx, buf + idx + cnt);
+        AllocTraits::deallocate(allocator(), buf, new_cap);
+        throw;
+    }
+    try {
+        detail::uninitialized_relocate(allocator(), ptr + idx, ptr + sz, buf + idx + cnt);
+    } catch(...) {
+        detail::destroy_before(allocator(), buf, new_cap, idx + cnt);
+        throw;
+    }
+    detail::stats::relocated<T>(sz);
+    detail::destroy(allocator(), ptr, ptr + sz);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(allocator(), ptr, cap);
+    ptr = buf;
+    sz += cnt;
+    cap = new_cap;
+    detail::zero_padding<Alloc>(ptr, sz);
+    return ptr + idx;
+}
+
+template <class T, class Alloc, class Size>
+template <class It>
+constexpr auto Vector<T, Alloc, Size>::append_counted(It first, size_t cnt) -> void {
+    detail::stats::copied<T>(cnt);
+    if (sz != 0 && sz + cnt > cap) {
+        reallocate_insert(sz, cnt, [&] (T* place) {
+            detail::uninitialized_copy(allocator(), std::move(first), cnt, place);
+        });
         return;
-    for (size_t i = 0; i < sz; ++i, ++first) {
-        try {
-            AllocTraits::construct(*this, ptr + i, *first);
-        } catch(...) {
-            detail::destroy_before(*this, ptr, cap, i);
-            throw;
+    }
+    if (sz + cnt > cap)
+        detail::reserve_strict(allocator(), ptr, sz, cap, cnt);
+    detail::uninitialized_copy(allocator(), std::move(first), cnt, ptr + sz);
+    sz += cnt;
+    detail::zero_padding<Alloc>(ptr, sz);
+}
+
+template <class T, class Alloc, class Size>
+template <class It>
+constexpr auto Vector<T, Alloc, Size>::insert_counted(size_t idx, It first, size_t new_sz) -> T* {
+    if (new_sz == 0)
+        return ptr + idx;
+    detail::stats::copied<T>(new_sz);
+    if (sz + new_sz > cap) {
+        return reallocate_insert(idx, new_sz, [&] (T* place) {
+            detail::uninitialized_copy(allocator(), first, new_sz, place);
+        });
+    }
+    T* old_end = ptr + sz;
+    size_t after = sz - idx;
+    detail::stats::moved<T>(after);
+    if (after > new_sz) {
+        detail::uninitialized_copy(allocator(), std::make_move_iterator(old_end - new_sz), new_sz, old_end);
+        sz += new_sz;
+        std::move_backward(ptr + idx, old_end - new_sz, old_end);
+        std::copy_n(first, new_sz, ptr + idx);
+    } else {
+        It mid = std::ranges::next(first, after);
+        detail::uninitialized_copy(allocator(), mid, new_sz - after, old_end);
+        sz += new_sz - after;
+        detail::uninitialized_copy(allocator(), std::make_move_iterator(ptr + idx), after, ptr + sz);
+        sz += after;
+        std::copy_n(first, after, ptr + idx);
+    }
+    detail::zero_padding<Alloc>(ptr, sz);
+    return ptr + idx;
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::note_operation() -> void {
+    if constexpr (detail::ShrinkingAllocator<Alloc>) {
+        const ShrinkPolicy& policy = allocator().shrink_policy();
+        if (sz * policy.low_water_ratio >= cap) {
+            shrink_state.idle_ops = 0;
+            return;
+        }
+        if (++shrink_state.idle_ops < policy.idle_ops)
+            return;
+        shrink_state.idle_ops = 0;
+        size_t new_cap = std::max(sz * policy.headroom, policy.min_capacity);
+        if (new_cap >= cap)
+            return;
+        if constexpr (detail::AllocatorShrinks<Alloc, T>) {
+            if (!std::is_constant_evaluated() && allocator().shrink_in_place(ptr, cap, new_cap)) {
+                cap = new_cap;
+                return;
+            }
         }
+        detail::reserve_strict(allocator(), ptr, sz, cap, new_cap);
     }
 }
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector() noexcept(noexcept(Alloc()))
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector() noexcept(noexcept(Alloc()))
 : Vector(Alloc()) {}
 
-template <class T, class Alloc> 
-constexpr Vector<T, Alloc>::Vector(const Alloc& alloc) noexcept
-: Vector::FinalHelper(alloc) {}
+template <class T, class Alloc, class Size> 
+constexpr Vector<T, Alloc, Size>::Vector(const Alloc& alloc) noexcept
+: detail::FinalHelper<Alloc>(alloc) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(size_t sz, const T& val, const Alloc& alloc)
-: Vector::FinalHelper(alloc), sz(sz), cap(sz), ptr(AllocTraits::allocate(*this, cap)) {
-    for (size_t i = 0; i < sz; ++i) {
-        try {
-            AllocTraits::construct(*this, ptr + i, val);
-        } catch(...) {
-            detail::destroy_before(*this, ptr, cap, i);
-            throw;
-        }
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(size_t sz, const T& val, const Alloc& alloc)
+: detail::FinalHelper<Alloc>(alloc), sz(detail::checked_size<Size>(sz)), cap(sz),
+  ptr(AllocTraits::allocate(allocator(), cap)) {
+    detail::stats::allocated<T>(cap, false);
+    detail::stats::copied<T>(sz);
+    try {
+        detail::uninitialized_fill(allocator(), ptr, sz, val);
+    } catch(...) {
+        AllocTraits::deallocate(allocator(), ptr, cap);
+        throw;
     }
+    detail::zero_padding<Alloc>(ptr, sz);
 }
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(size_t sz, const T& val)
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(size_t sz, const T& val)
 : Vector(sz, val, Alloc()) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(size_t sz, const Alloc& alloc)
-: Vector::FinalHelper(alloc), sz(sz), cap(sz), ptr(AllocTraits::allocate(*this, cap)) {
-    for (size_t i = 0; i < sz; ++i) {
-        try {
-            AllocTraits::construct(*this, ptr + i);
-        } catch(...) {
-            detail::destroy_before(*this, ptr, cap, i);
-            throw;
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(size_t sz, const Alloc& alloc)
+: detail::FinalHelper<Alloc>(alloc), sz(detail::checked_size<Size>(sz)), cap(sz) {
+    if constexpr (detail::can_zero_fill_v<Alloc, T>) {
+        if (!std::is_constant_evaluated()) {
+            ptr = detail::allocate_zeroed<T>(allocator(), cap);
+            detail::stats::allocated<T>(cap, false);
+            detail::zero_padding<Alloc>(ptr, sz);
+            return;
         }
     }
+    ptr = AllocTraits::allocate(allocator(), cap);
+    detail::stats::allocated<T>(cap, false);
+    try {
+        detail::uninitialized_value_construct(allocator(), ptr, sz);
+    } catch(...) {
+        AllocTraits::deallocate(allocator(), ptr, cap);
+        throw;
+    }
+    detail::zero_padding<Alloc>(ptr, sz);
 }
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(size_t sz)
-: Vector(sz, T(), Alloc()) {}
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(size_t sz)
+: Vector(sz, Alloc()) {}
 
-template <class T, class Alloc>
-template <class InputIt>
-constexpr Vector<T, Alloc>::Vector(InputIt first, InputIt last, const Alloc& alloc)
-: Vector(first, last, alloc, true) {}
+template <class T, class Alloc, class Size>
+template <std::input_iterator InputIt>
+constexpr Vector<T, Alloc, Size>::Vector(InputIt first, InputIt last, const Alloc& alloc)
+: Vector(alloc) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        append_counted(first, std::distance(first, last));
+    } else {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+}
 
-template <class T, class Alloc>
-template <class InputIt>
-constexpr Vector<T, Alloc>::Vector(InputIt first, InputIt last)
+template <class T, class Alloc, class Size>
+template <std::input_iterator InputIt>
+constexpr Vector<T, Alloc, Size>::Vector(InputIt first, InputIt last)
 : Vector(first, last, Alloc()) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(std::initializer_list<T> init, const Alloc& alloc)
+template <class T, class Alloc, class Size>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr Vector<T, Alloc, Size>::Vector(from_range_t, R&& range, const Alloc& alloc)
+: Vector(alloc) {
+    append_range(std::forward<R>(range));
+}
+
+template <class T, class Alloc, class Size>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr Vector<T, Alloc, Size>::Vector(from_range_t, R&& range)
+: Vector(from_range, std::forward<R>(range), Alloc()) {}
+
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(std::initializer_list<T> init, const Alloc& alloc)
 : Vector(init.begin(), init.end(), alloc) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(std::initializer_list<T> init)
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(std::initializer_list<T> init)
 : Vector(init, Alloc()) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(const Vector& other)
-: Vector(other, detail::copy_allocator(other)) {}
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(const Vector& other)
+: Vector(other, detail::copy_allocator(static_cast<const Alloc&>(other))) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(const Vector& other, const Alloc& alloc)
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(const Vector& other, const Alloc& alloc)
 : Vector(other.cbegin(), other.cend(), alloc) {}
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(Vector&& other) noexcept
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(Vector&& other) noexcept
 : Vector(static_cast<const Alloc&>(other)) {
     swap(other);
 }
 
-template <class T, class Alloc>
-constexpr Vector<T, Alloc>::Vector(Vector&& other, const Alloc& alloc)
-: Vector(
-std::make_move_iterator(other.cbegin()),
-std::make_move_iterator(other.cend()),
-alloc,
-&alloc == &other) {
-    if (&alloc != &other)
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::Vector(Vector&& other, const Alloc& alloc)
+: Vector(alloc) {
+    if (alloc == static_cast<const Alloc&>(other)) {
+        swap(other);
         return;
-    swap(other);
+    }
+    detail::reserve_strict(allocator(), ptr, sz, cap, other.sz);
+    detail::uninitialized_copy(allocator(), std::make_move_iterator(other.ptr), other.sz, ptr);
+    detail::stats::moved<T>(other.sz);
+    sz = other.sz;
+    detail::zero_padding<Alloc>(ptr, sz);
 }
 
-template <class T, class Alloc>
-Vector<T, Alloc>::~Vector() {
-    detail::destroy_before(*this, ptr, cap, sz);
+template <class T, class Alloc, class Size>
+constexpr Vector<T, Alloc, Size>::~Vector() {
+    detail::stats::released<T>(sz, cap);
+    detail::destroy_before(allocator(), ptr, cap, sz);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::operator=(const Vector& other) & -> Vector& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::operator=(const Vector& other) & -> Vector& {
     constexpr bool propagate = typename AllocTraits::propagate_on_container_copy_assignment();
     if constexpr (propagate) {
-        Vector<T, Alloc> copy(other, static_cast<const Alloc&>(other));
+        Vector<T, Alloc, Size> copy(other, static_cast<const Alloc&>(other));
         swap(copy);
     } else {
-        Vector<T, Alloc> copy(other, static_cast<const Alloc&>(*this));
+        Vector<T, Alloc, Size> copy(other, static_cast<const Alloc&>(*this));
         swap(copy);
     }
     return *this;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::operator=(Vector&& other) & -> Vector& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::operator=(Vector&& other) & -> Vector& {
     constexpr bool propagate = typename AllocTraits::propagate_on_container_move_assignment();
-    Vector<T, Alloc> empty;
-    if constexpr (propagate) {
-        Vector<T, Alloc> copy(other, static_cast<const Alloc&>(other));
-        swap(copy);
+    if constexpr (propagate || AllocTraits::is_always_equal::value) {
+        detail::destroy_before(allocator(), ptr, cap, sz);
+        sz = 0;
+        cap = 0;
+        ptr = nullptr;
+        if constexpr (propagate)
+            allocator() = std::move(other.allocator());
+        std::swap(sz, other.sz);
+        std::swap(cap, other.cap);
+        std::swap(ptr, other.ptr);
     } else {
-        Vector<T, Alloc> copy(other, static_cast<const Alloc&>(*this));
+        Vector<T, Alloc, Size> copy(std::move(other), static_cast<const Alloc&>(*this));
         swap(copy);
     }
-    other.swap(empty);
     return *this;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::swap(Vector& other) & noexcept -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::swap(Vector& other) & noexcept -> void {
     constexpr bool propagate = typename AllocTraits::propagate_on_container_swap();
     if constexpr (propagate)
-        std::swap(
-            static_cast<const Alloc&>(*this), 
-            static_cast<const Alloc&>(other)
-        );
+        std::swap(allocator(), other.allocator());
     std::swap(sz, other.sz);
     std::swap(cap, other.cap);
     std::swap(ptr, other.ptr);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::size() const noexcept -> size_t {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::size() const noexcept -> size_t {
     return sz;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::empty() const noexcept -> bool {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::empty() const noexcept -> bool {
     return sz == 0;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::capacity() const noexcept -> size_t {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::capacity() const noexcept -> size_t {
     return cap;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::get_allocator() const noexcept -> Alloc {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::max_size() const noexcept -> size_t {
+    return std::min<size_t>(std::numeric_limits<Size>::max(), AllocTraits::max_size(*this));
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::get_allocator() const noexcept -> Alloc {
     return *this;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::front() const noexcept -> const T& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::front() const noexcept -> const T& {
     return ptr[0];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::front() noexcept -> T& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::front() noexcept -> T& {
     return ptr[0];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::back() const noexcept -> const T& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::back() const noexcept -> const T& {
     return ptr[sz - 1];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::back() noexcept -> T& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::back() noexcept -> T& {
     return ptr[sz - 1];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::data() const noexcept -> const T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::data() const noexcept -> const T* {
     return ptr;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::data() noexcept -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::data() noexcept -> T* {
     return ptr;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::operator[](size_t idx) const noexcept -> const T& {
+template <class T, class Alloc, class Size>
+auto Vector<T, Alloc, Size>::padded_span() const noexcept -> std::span<const T> requires detail::PaddedAllocator<Alloc, T> {
+    const size_t lanes = Alloc::alignment / sizeof(T);
+    return {ptr, (sz + lanes - 1) / lanes * lanes};
+}
+
+template <class T, class Alloc, class Size>
+auto Vector<T, Alloc, Size>::padded_span() noexcept -> std::span<T> requires detail::PaddedAllocator<Alloc, T> {
+    return {ptr, std::as_const(*this).padded_span().size()};
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::operator[](size_t idx) const noexcept -> const T& {
     return ptr[idx];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::operator[](size_t idx) noexcept -> T& {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::operator[](size_t idx) noexcept -> T& {
     return ptr[idx];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::at(size_t idx) const -> const T& {
-    if (idx >= sz) {
-        char* buf;
-        sprintf(buf, detail::OUT_OF_RANGE_MSG, idx, sz);
-        throw std::out_of_range(buf);
-    }
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::at(size_t idx) const -> const T& {
+    if (idx >= sz)
+        detail::throw_out_of_range(idx, sz);
     return ptr[idx];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::at(size_t idx) -> T& {
-    if (idx >= sz) {
-        char* buf;
-        sprintf(buf, detail::OUT_OF_RANGE_MSG, idx, sz);
-        throw std::out_of_range(buf);
-    }
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::at(size_t idx) -> T& {
+    if (idx >= sz)
+        detail::throw_out_of_range(idx, sz);
     return ptr[idx];
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::assign(size_t new_sz, const T& val) -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::assign(size_t new_sz, const T& val) -> void {
     *this = Vector(new_sz, val);
 }
 
-template <class T, class Alloc>
-template <class InputIt>
-constexpr auto Vector<T, Alloc>::assign(InputIt first, InputIt last) -> void {
+template <class T, class Alloc, class Size>
+template <std::input_iterator InputIt>
+constexpr auto Vector<T, Alloc, Size>::assign(InputIt first, InputIt last) -> void {
     *this = Vector(first, last);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::assign(std::initializer_list<T> init) -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::assign(std::initializer_list<T> init) -> void {
     *this = Vector(init);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::reserve(size_t new_cap) -> void {
+template <class T, class Alloc, class Size>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto Vector<T, Alloc, Size>::assign_range(R&& range) -> void {
+    clear();
+    append_range(std::forward<R>(range));
+}
+
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::reserve(size_t new_cap) -> void {
     if (new_cap <= cap) 
         return;
-    size_t buf_cap = cap;
-    while (new_cap > buf_cap)
-        buf_cap *= detail::GROWTH_RATE;
-    detail::reserve_strict(*this, ptr, sz, cap, buf_cap);
+    detail::reserve_strict(allocator(), ptr, sz, cap, grown_capacity(new_cap));
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::shrink_to_fit() -> void {
-    detail::reserve_strict(*this, ptr, sz, cap, sz);
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::shrink_to_fit() -> void {
+    if (sz == cap)
+        return;
+    detail::reserve_strict(allocator(), ptr, sz, cap, sz);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::resize(size_t new_sz, const T& val) -> void {
-    if (sz == new_sz)
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::resize(size_t new_sz, const T& val) -> void {
+    if (new_sz <= sz) {
+        erase(cbegin() + new_sz, cend());
         return;
-    size_t new_cap = cap;
-    while (new_sz > new_cap)
-        new_cap *= detail::GROWTH_RATE;
-    T* buf = AllocTraits::allocate(*this, new_cap);
-    for (size_t i = 0; i < new_sz; ++i) {
-        try {
-            const T& curr_val = i < sz ? ptr[i] : val;
-            AllocTraits::construct(*this, buf + i, curr_val);
-        } catch(...) {
-            detail::destroy_before(*this, buf, new_cap, i);
-            throw;
-        }
-    }
-    try {
-        AllocTraits::deallocate(*this, ptr, cap);
-    } catch(...) {
-        detail::destroy_before(*this, buf, new_cap, new_sz);
-        throw;
     }
-    ptr = buf;
-    sz = new_sz;
-    cap = new_cap;
+    insert(cend(), new_sz - sz, val);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::resize(size_t new_sz) -> void {
-    resize(new_sz, T());
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::resize(size_t new_sz) -> void {
+    if (new_sz <= sz) {
+        erase(cbegin() + new_sz, cend());
+        return;
+    }
+    reserve(new_sz);
+    detail::uninitialized_value_construct(allocator(), ptr + sz, new_sz - sz);
+    sz = new_sz;
+    detail::zero_padding<Alloc>(ptr, sz);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Size>
 template <class... Args>
-constexpr auto Vector<T, Alloc>::emplace(const T* pos, Args&&... args) -> T* {
-    if (pos == cend())
+constexpr auto Vector<T, Alloc, Size>::emplace(const T* pos, Args&&... args) -> T* {
+    size_t idx = pos - ptr;
+    if (idx == sz) {
         emplace_back(std::forward<Args>(args)...);
-    size_t new_cap = cap;
-    if (sz + 1 > new_cap)
-        new_cap *= detail::GROWTH_RATE;
-    T* buf = AllocTraits::allocate(*this, new_cap);
-    const T* iter = cbegin();
-    for (size_t i = 0; i <= sz; ++i, ++iter) {
-        try {
-            if (iter < pos) {
-                AllocTraits::construct(*this, buf + i, ptr[i]);
-                continue;
-            }
-            if (iter > pos) {
-                AllocTraits::construct(*this, buf + i, ptr[i]);
-                continue;
-            }
-            AllocTraits::construct(*this, buf + i, std::forward<Args>(args)...);
-        } catch(...) {
-            detail::destroy_before(*this, buf, new_cap, i);
-            throw;
-        }
+        return ptr + idx;
     }
-    try {
-        AllocTraits::deallocate(*this, ptr, cap);
-    } catch(...) {
-        detail::destroy_before(*this, buf, new_cap, sz + 1);
-        throw;
+    if (sz == cap) {
+        return reallocate_insert(idx, 1, [&] (T* place) {
+            AllocTraits::construct(allocator(), place, std::forward<Args>(args)...);
+        });
     }
-    T* res = buf + (pos - ptr);
-    ptr = buf;
+    detail::stats::moved<T>(sz - idx);
+    T val(std::forward<Args>(args)...);
+    AllocTraits::construct(allocator(), ptr + sz, std::move(ptr[sz - 1]));
     ++sz;
-    cap = new_cap;
-    return res;
+    std::move_backward(ptr + idx, ptr + sz - 2, ptr + sz - 1);
+    ptr[idx] = std::move(val);
+    detail::zero_padding<Alloc>(ptr, sz);
+    return ptr + idx;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::insert(const T* pos, const T& val) -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::insert(const T* pos, const T& val) -> T* {
     return emplace(pos, val);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::insert(const T* pos, T&& val) -> T* {
-    return emplace(pos, std::move_if_noexcept(val));
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::insert(const T* pos, T&& val) -> T* {
+    return emplace(pos, std::move(val));
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::insert(const T* pos, size_t new_sz, const T& val) -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::insert(const T* pos, size_t new_sz, const T& val) -> T* {
+    size_t idx = pos - ptr;
     if (new_sz == 0)
-        return pos;
-    T* res = pos;
-    for (size_t i = 0; i < new_sz; ++i) {
-        try {
-            res = insert(res + 1, val);
-        } catch(...) {
-            try {
-                erase(res - i, res);
-            } catch(...) {}
-            throw;
-        }
+        return ptr + idx;
+    detail::stats::copied<T>(new_sz);
+    if (sz + new_sz > cap) {
+        return reallocate_insert(idx, new_sz, [&] (T* place) {
+            detail::uninitialized_fill(allocator(), place, new_sz, val);
+        });
+    }
+    T copy(val);
+    T* old_end = ptr + sz;
+    size_t after = sz - idx;
+    detail::stats::moved<T>(after);
+    if (after > new_sz) {
+        detail::uninitialized_copy(allocator(), std::make_move_iterator(old_end - new_sz), new_sz, old_end);
+        sz += new_sz;
+        std::move_backward(ptr + idx, old_end - new_sz, old_end);
+        std::fill(ptr + idx, ptr + idx + new_sz, copy);
+    } else {
+        detail::uninitialized_fill(allocator(), old_end, new_sz - after, copy);
+        sz += new_sz - after;
+        detail::uninitialized_copy(allocator(), std::make_move_iterator(ptr + idx), after, ptr + sz);
+        sz += after;
+        std::fill(ptr + idx, old_end, copy);
     }
-    return res - new_sz + 1;
+    detail::zero_padding<Alloc>(ptr, sz);
+    return ptr + idx;
 }
 
-template <class T, class Alloc>
-template <class InputIt>
-constexpr auto Vector<T, Alloc>::insert(const T* pos, InputIt first, InputIt last) -> T* {
-    if (first == last)
-        return pos;
-    size_t new_sz = std::distance(first, last);
-    T* res = pos;
-    for (size_t i = 0; i < new_sz; ++i, ++first) {
-        try {
-            res = insert(res + 1, *first);
-        } catch(...) {
-            try {
-                erase(res - i, res);
-            } catch(...) {}
-            throw;
-        }
+template <class T, class Alloc, class Size>
+template <std::input_iterator InputIt>
+constexpr auto Vector<T, Alloc, Size>::insert(const T* pos, InputIt first, InputIt last) -> T* {
+    size_t idx = pos - ptr;
+    if constexpr (std::forward_iterator<InputIt>) {
+        return insert_counted(idx, first, std::distance(first, last));
+    } else {
+        size_t old_sz = sz;
+        for (; first != last; ++first)
+            emplace_back(*first);
+        std::rotate(ptr + idx, ptr + old_sz, ptr + sz);
+        return ptr + idx;
     }
-    return res - new_sz + 1;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::insert(const T* pos, std::initializer_list<T> init) -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::insert(const T* pos, std::initializer_list<T> init) -> T* {
     return insert(pos, init.begin(), init.end());
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Size>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto Vector<T, Alloc, Size>::insert_range(const T* pos, R&& range) -> T* {
+    size_t idx = pos - ptr;
+    if constexpr (std::ranges::forward_range<R>) {
+        return insert_counted(idx, std::ranges::begin(range), std::ranges::distance(range));
+    } else {
+        size_t old_sz = sz;
+        append_range(std::forward<R>(range));
+        std::rotate(ptr + idx, ptr + old_sz, ptr + sz);
+        return ptr + idx;
+    }
+}
+
+template <class T, class Alloc, class Size>
+template <detail::ContainerCompatibleRange<T> R>
+constexpr auto Vector<T, Alloc, Size>::append_range(R&& range) -> void {
+    if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+        append_counted(std::ranges::begin(range), std::ranges::distance(range));
+    } else {
+        for (auto&& elem : range)
+            emplace_back(std::forward<decltype(elem)>(elem));
+    }
+}
+
+template <class T, class Alloc, class Size>
 template <class... Args>
-constexpr auto Vector<T, Alloc>::emplace_back(Args&&... args) -> T& {
-    reserve(sz + 1);
-    try {
-        AllocTraits::construct(*this, end(), std::forward<Args>(args)...);
-    } catch(...) {
-        try {
-            AllocTraits::destroy(*this, end());
-        } catch(...) {}
-        throw;
+constexpr auto Vector<T, Alloc, Size>::emplace_back(Args&&... args) -> T& {
+    if (sz == cap) {
+        reallocate_insert(sz, 1, [&] (T* place) {
+            AllocTraits::construct(allocator(), place, std::forward<Args>(args)...);
+        });
+        return back();
     }
+    AllocTraits::construct(allocator(), end(), std::forward<Args>(args)...);
     ++sz;
+    detail::zero_padding<Alloc>(ptr, sz);
     return back();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::push_back(const T& val) -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::push_back(const T& val) -> void {
+    detail::stats::copied<T>(1);
     emplace_back(val);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::push_back(T&& val) -> void {
-    emplace_back(std::move_if_noexcept(val));
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::push_back(T&& val) -> void {
+    detail::stats::moved<T>(1);
+    emplace_back(std::move(val));
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::erase(const T* pos) -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::erase(const T* pos) -> T* {
     return erase(pos, pos + 1);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::erase(const T* first, const T* last) -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::erase(const T* first, const T* last) -> T* {
+    T* res = ptr + (first - ptr);
     size_t new_sz = std::distance(first, last);
-    T* buf = AllocTraits::allocate(*this, cap);
-    T* iter = cbegin();
-    for (size_t i = 0; i < sz; ++i, ++iter) {
-        try {
-            if (iter < first) {
-                AllocTraits::construct(*this, buf + i, ptr[i]);
-            }
-            if (iter >= last) {
-                AllocTraits::construct(*this, buf - new_sz + i, ptr[i]);
+    if (new_sz == 0)
+        return res;
+    detail::stats::moved<T>(end() - res - new_sz);
+    std::move(res + new_sz, end(), res);
+    detail::destroy(allocator(), end() - new_sz, end());
+    sz -= new_sz;
+    detail::zero_padding<Alloc>(ptr, sz);
+    size_t idx = res - ptr;
+    note_operation();
+    return ptr + idx;
+}
+
+template <class T, class Alloc, class Size>
+template <std::ranges::forward_range R>
+constexpr auto Vector<T, Alloc, Size>::erase_indices(R&& indices) -> size_t {
+    auto it = std::ranges::begin(indices);
+    auto last = std::ranges::end(indices);
+    if (it == last)
+        return 0;
+    size_t prev = 0;
+    for (auto check = it; check != last; ++check) {
+        size_t idx = *check;
+        if (idx >= sz)
+            detail::throw_out_of_range(idx, sz);
+        if (idx < prev)
+            throw std::invalid_argument(detail::UNSORTED_INDICES_MSG);
+        prev = idx;
+    }
+    size_t read = *it;
+    size_t write = read;
+    size_t first = read;
+    for (; it != last; ++it) {
+        size_t idx = *it;
+        if (idx < read)
+            continue;
+        std::move(ptr + read, ptr + idx, ptr + write);
+        write += idx - read;
+        read = idx + 1;
+    }
+    std::move(ptr + read, ptr + sz, ptr + write);
+    write += sz - read;
+    detail::stats::moved<T>(write - first);
+    size_t erased = sz - write;
+    detail::destroy(allocator(), ptr + write, ptr + sz);
+    sz = write;
+    detail::zero_padding<Alloc>(ptr, sz);
+    note_operation();
+    return erased;
+}
+
+template <class T, class Alloc, class Size>
+template <class BoolAlloc>
+constexpr auto Vector<T, Alloc, Size>::erase_mask(const Vector<bool, BoolAlloc>& mask) -> size_t {
+    const size_t WORD_BITS = 64;
+    size_t write = 0;
+    size_t first = sz;
+    for (size_t base = 0; base < sz; base += WORD_BITS) {
+        size_t cnt = std::min(WORD_BITS, sz - base);
+        uint64_t word = base < mask.size() ? mask.word(base / WORD_BITS) : 0;
+        uint64_t keep = cnt < WORD_BITS ? ~word & ((uint64_t(1) << cnt) - 1) : ~word;
+        if (word == 0) {
+            if (write != base)
+                std::move(ptr + base, ptr + base + cnt, ptr + write);
+            write += cnt;
+            continue;
+        }
+        if (first == sz)
+            first = std::min(sz, base + std::countr_zero(word));
+        if (keep == 0)
+            continue;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                write += detail::compress(ptr + base, keep, cnt, ptr + write);
+                continue;
             }
-        } catch(...) {
-            detail::destroy_before(*this, buf, cap, iter < first ? i : i - new_sz);
-            throw;
+        }
+        for (; keep != 0; keep &= keep - 1) {
+            size_t idx = base + std::countr_zero(keep);
+            if (write != idx)
+                ptr[write] = std::move(ptr[idx]);
+            ++write;
         }
     }
-    try {
-        AllocTraits::deallocate(*this, ptr, cap);
-    } catch(...) {
-        detail::destroy_before(*this, buf, cap, sz - 1);
-        throw;
-    }
-    T* res = buf + (last - ptr);
-    ptr = buf;
-    sz -= new_sz;
-    return res;
+    detail::stats::moved<T>(write - first);
+    size_t erased = sz - write;
+    detail::destroy(allocator(), ptr + write, ptr + sz);
+    sz = write;
+    detail::zero_padding<Alloc>(ptr, sz);
+    note_operation();
+    return erased;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::pop_back() -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::pop_back() -> void {
     erase(cend() - 1);
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::clear() -> void {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::clear() -> void {
     erase(cbegin(), cend());
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::begin() const noexcept -> const T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::begin() const noexcept -> const T* {
     return ptr;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::begin() noexcept -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::begin() noexcept -> T* {
     return ptr;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::cbegin() const noexcept -> const T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::cbegin() const noexcept -> const T* {
     return ptr;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::rbegin() const noexcept -> const reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::rbegin() const noexcept -> const reverse_iterator {
     return cend();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::rbegin() noexcept -> reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::rbegin() noexcept -> reverse_iterator {
     return end();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::crbegin() const noexcept -> const reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::crbegin() const noexcept -> const reverse_iterator {
     return cend();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::end() const noexcept -> const T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::end() const noexcept -> const T* {
     return ptr + sz;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::end() noexcept -> T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::end() noexcept -> T* {
     return ptr + sz;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::cend() const noexcept -> const T* {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::cend() const noexcept -> const T* {
     return ptr + sz;
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::rend() const noexcept -> const reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::rend() const noexcept -> const reverse_iterator {
     return cbegin();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::rend() noexcept -> reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::rend() noexcept -> reverse_iterator {
     return begin();
 }
 
-template <class T, class Alloc>
-constexpr auto Vector<T, Alloc>::crend() const noexcept -> const reverse_iterator {
+template <class T, class Alloc, class Size>
+constexpr auto Vector<T, Alloc, Size>::crend() const noexcept -> const reverse_iterator {
     return cbegin();
 }
 
-template <class T, class Alloc>
-constexpr auto operator==(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs) -> bool {
+template <class T, class Alloc, class Size>
+constexpr auto operator==(const Vector<T, Alloc, Size>& lhs, const Vector<T, Alloc, Size>& rhs) -> bool {
     if (lhs.size() != rhs.size())
         return false;
     for (size_t i = 0; i < lhs.size(); ++i)
@@ -588,11 +997,11 @@ constexpr auto operator==(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& r
     return true;
 }
 
-template <class T, class Alloc>
-constexpr auto operator<=>(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs)
+template <class T, class Alloc, class Size>
+constexpr auto operator<=>(const Vector<T, Alloc, Size>& lhs, const Vector<T, Alloc, Size>& rhs)
 -> std::weak_ordering {
     for (size_t i = 0; i < std::min(lhs.size(), rhs.size()); ++i) {
-        std::strong_ordering elem_order = lhs[i] <=> rhs[i];
+        std::weak_ordering elem_order = std::compare_weak_order_fallback(lhs[i], rhs[i]);
         if (elem_order != 0)
             return elem_order;
     }
@@ -600,29 +1009,32 @@ constexpr auto operator<=>(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>&
     return sz_order;
 }
 
-template <class T, class Alloc, class Pred>
-constexpr auto erase_if(Vector<T, Alloc>& vec, Pred pred) -> size_t {
-    size_t res = 0;
-    for (size_t i = 0; i < vec.size(); ++i) {
-        if (pred(vec[i])) {
-            vec.erase(vec.begin() + i);
-            ++i;
-            ++res;
-        }
-    }
-    return res;
+template <class T, class Alloc, class Size, class Pred>
+constexpr auto erase_if(Vector<T, Alloc, Size>& vec, Pred pred) -> size_t {
+    T* res = std::remove_if(vec.begin(), vec.end(), pred);
+    size_t cnt = vec.end() - res;
+    vec.erase(res, vec.end());
+    return cnt;
 }
 
-template <class T, class Alloc, class U>
-constexpr auto erase(Vector<T, Alloc>& vec, const U& val) -> size_t {
-    return erase_if(vec, [val] (const T& elem) -> bool {
-        return elem = val;
+template <class T, class Alloc, class Size, class U>
+constexpr auto erase(Vector<T, Alloc, Size>& vec, const U& val) -> size_t {
+    return erase_if(vec, [&val] (const T& elem) -> bool {
+        return elem == val;
     });
 }
 
 namespace std {
-    template <class T, class Alloc>
-    constexpr auto swap(Vector<T, Alloc>& lhs, Vector<T, Alloc>& rhs) -> void {
+    template <class T, class Alloc, class Size>
+    constexpr auto swap(Vector<T, Alloc, Size>& lhs, Vector<T, Alloc, Size>& rhs) -> void {
         lhs.swap(rhs);
     }
 }
+
+template <auto Generator>
+constexpr auto freeze() -> std::array<typename decltype(Generator())::value_type, Generator().size()> {
+    std::array<typename decltype(Generator())::value_type, Generator().size()> res{};
+    auto vec = Generator();
+    std::copy(vec.begin(), vec.end(), res.begin());
+    return res;
+}
@@ -2,15 +2,34 @@
 
 #define VECTOR_BASE_H
 
+#include "aligned_allocator.hpp"
 #include "final_helper.hpp"
+#include "shrink_allocator.hpp"
 #include "util.hpp"
+#include "vector_bool.hpp"
+#include "vector_stats.hpp"
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <compare>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
 
-template <class T, class Alloc = std::allocator<T>>
+#ifdef __cpp_lib_containers_ranges
+using std::from_range_t;
+using std::from_range;
+#else
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+
+inline constexpr from_range_t from_range{};
+#endif
+
+template <class T, class Alloc, class Size>
 class Vector: private detail::FinalHelper<Alloc> {
 public:
     using value_type = T;
@@ -31,23 +50,28 @@ public:
     constexpr Vector(size_t sz, const T& val);
     constexpr Vector(size_t sz, const Alloc& alloc);
     explicit constexpr Vector(size_t sz);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr Vector(InputIt first, InputIt last, const Alloc& alloc);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr Vector(InputIt first, InputIt last);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr Vector(from_range_t, R&& range, const Alloc& alloc);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr Vector(from_range_t, R&& range);
     constexpr Vector(std::initializer_list<T> init, const Alloc& alloc);
     constexpr Vector(std::initializer_list<T> init);
     constexpr Vector(const Vector& other);
     constexpr Vector(const Vector& other, const Alloc& alloc);
     constexpr Vector(Vector&& other) noexcept;
     constexpr Vector(Vector&& other, const Alloc& alloc);
-    ~Vector();
+    constexpr ~Vector();
     constexpr Vector& operator=(const Vector& rhs) &;
     constexpr Vector& operator=(Vector&& other) &;
     constexpr void swap(Vector& other) & noexcept;
     constexpr size_t size() const noexcept;
     constexpr bool empty() const noexcept;
     constexpr size_t capacity() const noexcept;
+    constexpr size_t max_size() const noexcept;
     constexpr Alloc get_allocator() const noexcept;
     constexpr const T& front() const noexcept;
     constexpr T& front() noexcept;
@@ -55,14 +79,18 @@ public:
     constexpr T& back() noexcept;
     constexpr const T* data() const noexcept;
     constexpr T* data() noexcept;
+    std::span<const T> padded_span() const noexcept requires detail::PaddedAllocator<Alloc, T>;
+    std::span<T> padded_span() noexcept requires detail::PaddedAllocator<Alloc, T>;
     constexpr const T& operator[](size_t idx) const noexcept;
     constexpr T& operator[](size_t idx) noexcept;
     constexpr const T& at(size_t idx) const;
     constexpr T& at(size_t idx);
     constexpr void assign(size_t new_sz, const T& val);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr void assign(InputIt first, InputIt last);
     constexpr void assign(std::initializer_list<T> init);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr void assign_range(R&& range);
     constexpr void reserve(size_t new_cap);
     constexpr void shrink_to_fit();
     constexpr void resize(size_t new_sz, const T& val);
@@ -72,15 +100,23 @@ public:
     constexpr T* insert(const T* pos, const T& val);
     constexpr T* insert(const T* pos, T&& val);
     constexpr T* insert(const T* pos, size_t new_sz, const T& val);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr T* insert(const T* pos, InputIt first, InputIt last);
     constexpr T* insert(const T* pos, std::initializer_list<T> init);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr T* insert_range(const T* pos, R&& range);
+    template <detail::ContainerCompatibleRange<T> R>
+    constexpr void append_range(R&& range);
     template <class... Args>
     constexpr T& emplace_back(Args&&... args);
     constexpr void push_back(const T& val);
     constexpr void push_back(T&& val);
     constexpr T* erase(const T* pos);
     constexpr T* erase(const T* first, const T* last);
+    template <std::ranges::forward_range R>
+    constexpr size_t erase_indices(R&& indices);
+    template <class BoolAlloc>
+    constexpr size_t erase_mask(const Vector<bool, BoolAlloc>& mask);
     constexpr void pop_back();
     constexpr void clear();
     constexpr const T* begin() const noexcept;
@@ -97,32 +133,53 @@ public:
     constexpr const reverse_iterator crend() const noexcept;
 private:
     using AllocTraits = std::allocator_traits<Alloc>;
-    template <class InputIt>
-    constexpr Vector(InputIt first, InputIt last, const Alloc& alloc, bool copy);
-    size_t sz = 0;
-    size_t cap = 0;
+    constexpr Alloc& allocator() noexcept;
+    constexpr size_t grown_capacity(size_t min_cap) const;
+    template <class F>
+    constexpr T* reallocate_insert(size_t idx, size_t cnt, F&& construct);
+    template <class It>
+    constexpr void append_counted(It first, size_t cnt);
+    template <class It>
+    constexpr T* insert_counted(size_t idx, It first, size_t cnt);
+    constexpr void note_operation();
+    Size sz = 0;
+    Size cap = 0;
     T* ptr = nullptr;
+    [[no_unique_address]] detail::ShrinkState<detail::ShrinkingAllocator<Alloc>> shrink_state;
 };
 
-template <class InputIt, class _Alloc>
+template <class T, size_t Align = 64>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>>;
+
+template <class T, class Alloc = std::allocator<T>>
+using CompactVector = Vector<T, Alloc, uint32_t>;
+
+template <std::input_iterator InputIt, class _Alloc>
 Vector(InputIt first, InputIt last, const _Alloc& alloc) 
 -> Vector<typename std::iterator_traits<InputIt>::value_type, _Alloc>;
 
-template <class T, class Alloc>
-constexpr bool operator==(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs);
+template <std::ranges::input_range R, class _Alloc = std::allocator<std::ranges::range_value_t<R>>>
+Vector(from_range_t, R&& range, const _Alloc& alloc = _Alloc())
+-> Vector<std::ranges::range_value_t<R>, _Alloc>;
+
+template <class T, class Alloc, class Size>
+constexpr bool operator==(const Vector<T, Alloc, Size>& lhs, const Vector<T, Alloc, Size>& rhs);
+
+template <class T, class Alloc, class Size>
+constexpr std::weak_ordering operator<=>(const Vector<T, Alloc, Size>& lhs, const Vector<T, Alloc, Size>& rhs);
 
-template <class T, class Alloc>
-constexpr std::weak_ordering operator<=>(const Vector<T, Alloc>& lhs, const Vector<T, Alloc>& rhs);
+template <class T, class Alloc, class Size, class U = T>
+constexpr size_t erase(Vector<T, Alloc, Size>& vec, const U& val);
 
-template <class T, class Alloc, class U = T>
-constexpr size_t erase(Vector<T, Alloc>& vec, const U& val);
+template <class T, class Alloc, class Size, class Pred>
+constexpr size_t erase_if(Vector<T, Alloc, Size>& vec, Pred pred);
 
-template <class T, class Alloc, class Pred>
-constexpr size_t erase_if(Vector<T, Alloc>& vec, Pred pred);
+template <auto Generator>
+constexpr std::array<typename decltype(Generator())::value_type, Generator().size()> freeze();
 
 namespace std {
-    template <class T, class Alloc>
-    constexpr void swap(Vector<T, Alloc>& lhs, Vector<T, Alloc>& rhs);
+    template <class T, class Alloc, class Size>
+    constexpr void swap(Vector<T, Alloc, Size>& lhs, Vector<T, Alloc, Size>& rhs);
 }
 
 #define HEADER_INCLUDES
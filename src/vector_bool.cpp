@@ -1,21 +1,50 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
 #include "vector_bool.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
 
-namespace {
-    void destroy_before(Alloc& alloc, uint8_t* buf, size_t cap, size_t i) {
-        using AllocTraits = std::allocator_traits<Alloc>::rebind_traits<uint8_t>;
-        while (i) {
-            --i;
-            try {
-                AllocTraits::destry(alloc, buf + i);
-            } catch(...) {
-                break;
-            }
-        }
-        try {
-            AllocTraits::deallocate(alloc, buf, cap * BITS_IN_BYTE);
-        } catch(...) {}
-    }
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::bytes_for(size_t bits) noexcept -> size_t {
+    return (bits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::words_for(size_t bits) noexcept -> size_t {
+    return (bits + BITS_IN_WORD - 1) / BITS_IN_WORD;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::adopted_capacity(size_t word_cap, size_t bits) -> size_t {
+    if (word_cap > SIZE_MAX / BITS_IN_WORD || bits > word_cap * BITS_IN_WORD)
+        throw std::length_error(SHORT_BUFFER_MSG);
+    return word_cap * BITS_IN_WORD;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::reallocate(size_t new_cap) -> void {
+    uint64_t* buf = new_cap ? AllocTraits::allocate(alloc, words_for(new_cap)) : nullptr;
+    std::copy_n(ptr, words_for(std::min(sz, new_cap)), buf);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, words_for(cap));
+    ptr = buf;
+    cap = new_cap;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::clear_tail() noexcept -> void {
+    if (sz % BITS_IN_WORD != 0)
+        ptr[sz / BITS_IN_WORD] &= (uint64_t(1) << (sz % BITS_IN_WORD)) - 1;
 }
 
 template <class Alloc>
@@ -23,67 +52,359 @@ constexpr Vector<bool, Alloc>::Vector() noexcept(noexcept(Alloc()))
 : Vector(Alloc()) {}
 
 template <class Alloc>
-constexpr Vector<bool, Alloc>::Vector(const Alloc& alloc)
-: alloc(alloc), cap(0) {}
+constexpr Vector<bool, Alloc>::Vector(const Alloc& alloc) noexcept
+: alloc(alloc) {}
 
 template <class Alloc>
-constexpr Vector<bool, Alloc>::Vector(size_t sz, const T& val, const Alloc& alloc)
-: alloc(alloc), sz(sz) {
-    while (sz > cap)
-        cap *= GROWTH_RATE;
-    ptr = AllocTraits::allocate(alloc, cap * BITS_IN_BYTE);
-    for (size_t i = 0; i < sz; ++i) {
-        try {
-            AllocTraits::construct(alloc, ptr + i, val);
-        } catch(...) {
-            destroy_before(alloc, ptr, cap, i);
-            throw;
-        }
-    }
+constexpr Vector<bool, Alloc>::Vector(size_t sz, const bool& val, const Alloc& alloc)
+: Vector(alloc) {
+    resize(sz, val);
 }
 
 template <class Alloc>
-constexpr Vector<bool, Alloc>::Vector(size_t sz, const T& val)
+constexpr Vector<bool, Alloc>::Vector(size_t sz, const bool& val)
 : Vector(sz, val, Alloc()) {}
 
 template <class Alloc>
 constexpr Vector<bool, Alloc>::Vector(size_t sz)
-: Vector(sz, T(), Alloc()) {}
+: Vector(sz, false, Alloc()) {}
 
 template <class Alloc>
 constexpr Vector<bool, Alloc>::Vector(size_t sz, const Alloc& alloc)
-: alloc(alloc), sz(sz) {
-    while (sz > cap)
-        cap *= GROWTH_RATE;
-    ptr = AllocTraits::allocate(alloc, cap * BITS_IN_BYTE);
-    for (size_t i = 0; i < sz; ++i) {
-        try {
-            AllocTraits::construct(alloc, ptr + i);
-        } catch(...) {
-            destroy_before(alloc, ptr, cap, i);
-            throw;
-        }
-    }
-}
+: Vector(sz, false, alloc) {}
 
 template <class Alloc>
-template <class InputIt>
+template <std::input_iterator InputIt>
 constexpr Vector<bool, Alloc>::Vector(InputIt first, InputIt last, const Alloc& alloc)
-: alloc(alloc), sz(std::distance(first, last)) {
-    while (sz > cap)
-        cap *= GROWTH_RATE;
-    ptr = AllocTraits::allocate(alloc, cap * BITS_IN_BYTE);
-    for (size_t i = 0; i < sz; ++i, ++first) {
-        try {
-            AllocTraits::construct(alloc, ptr + i, *first);
-        } catch(...) {
-            destroy_before(alloc, ptr, cap, i);
-            throw;
-        }
-    }
+: Vector(alloc) {
+    for (; first != last; ++first)
+        push_back(*first);
 }
 
 template <class Alloc>
-template <class InputIt>
+template <std::input_iterator InputIt>
 constexpr Vector<bool, Alloc>::Vector(InputIt first, InputIt last)
 : Vector(first, last, Alloc()) {}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(const Vector& other)
+: Vector(other, std::allocator_traits<Alloc>::select_on_container_copy_construction(Alloc(other.alloc))) {}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(const Vector& other, const Alloc& alloc)
+: Vector(alloc) {
+    reallocate(other.sz);
+    std::copy_n(other.ptr, words_for(other.sz), ptr);
+    sz = other.sz;
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(Vector&& other) noexcept
+: alloc(other.alloc) {
+    swap(other);
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(Vector&& other, const Alloc& alloc)
+: Vector(alloc) {
+    if (this->alloc == other.alloc) {
+        swap(other);
+        return;
+    }
+    reallocate(other.sz);
+    std::copy_n(other.ptr, words_for(other.sz), ptr);
+    sz = other.sz;
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(std::initializer_list<bool> init, const Alloc& alloc)
+: Vector(init.begin(), init.end(), alloc) {}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(std::initializer_list<bool> init)
+: Vector(init, Alloc()) {}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(std::span<const uint64_t> words, size_t bits, const Alloc& alloc)
+: Vector(alloc) {
+    assign(words, bits);
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(std::span<const uint64_t> words, size_t bits)
+: Vector(words, bits, Alloc()) {}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits, const Alloc& alloc)
+: alloc(alloc), sz(bits), cap(adopted_capacity(word_cap, bits)), ptr(words) {
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::Vector(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits)
+: Vector(adopt_words, words, word_cap, bits, Alloc()) {}
+
+template <class Alloc>
+auto Vector<bool, Alloc>::from_bytes(std::span<const std::byte> bytes, size_t bits, const Alloc& alloc) -> Vector {
+    size_t cnt = bytes_for(bits);
+    if (bytes.size() < cnt)
+        throw std::length_error(SHORT_SPAN_MSG);
+    Vector res(alloc);
+    res.reserve(bits);
+    if (bits == 0)
+        return res;
+    if constexpr (std::endian::native == std::endian::little) {
+        res.ptr[words_for(bits) - 1] = 0;
+        std::memcpy(res.ptr, bytes.data(), cnt);
+    } else {
+        std::fill_n(res.ptr, words_for(bits), 0);
+        for (size_t i = 0; i < cnt; ++i)
+            res.ptr[i / sizeof(uint64_t)] |= static_cast<uint64_t>(bytes[i]) << (i % sizeof(uint64_t) * BITS_IN_BYTE);
+    }
+    res.sz = bits;
+    res.clear_tail();
+    return res;
+}
+
+template <class Alloc>
+constexpr Vector<bool, Alloc>::~Vector() {
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, words_for(cap));
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::operator=(const Vector& other) & -> Vector& {
+    Vector copy(other, Alloc(alloc));
+    swap(copy);
+    return *this;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::operator=(Vector&& other) & noexcept -> Vector& {
+    Vector empty(Alloc(other.alloc));
+    swap(other);
+    other.swap(empty);
+    return *this;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::swap(Vector& other) & noexcept -> void {
+    std::swap(alloc, other.alloc);
+    std::swap(sz, other.sz);
+    std::swap(cap, other.cap);
+    std::swap(ptr, other.ptr);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::size() const noexcept -> size_t {
+    return sz;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::empty() const noexcept -> bool {
+    return sz == 0;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::capacity() const noexcept -> size_t {
+    return cap;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::get_allocator() const noexcept -> Alloc {
+    return Alloc(alloc);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::assign(std::span<const uint64_t> words, size_t bits) -> void {
+    size_t cnt = words_for(bits);
+    if (words.size() < cnt)
+        throw std::length_error(SHORT_SPAN_MSG);
+    if (bits > cap) {
+        Vector res(get_allocator());
+        res.reserve(bits);
+        std::copy_n(words.data(), cnt, res.ptr);
+        res.sz = bits;
+        res.clear_tail();
+        swap(res);
+        return;
+    }
+    if (words.data() != ptr)
+        std::copy_n(words.data(), cnt, ptr);
+    sz = bits;
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::assign(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits) -> void {
+    if (words != nullptr && words == ptr)
+        throw std::invalid_argument(SELF_ADOPT_MSG);
+    size_t new_cap = adopted_capacity(word_cap, bits);
+    if (ptr != nullptr)
+        AllocTraits::deallocate(alloc, ptr, words_for(cap));
+    ptr = words;
+    cap = new_cap;
+    sz = bits;
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::words() const noexcept -> std::span<const uint64_t> {
+    return {ptr, words_for(sz)};
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::words() noexcept -> std::span<uint64_t> {
+    return {ptr, words_for(sz)};
+}
+
+template <class Alloc>
+auto Vector<bool, Alloc>::bytes() const noexcept -> std::span<const std::byte> {
+    return {reinterpret_cast<const std::byte*>(ptr), bytes_for(sz)};
+}
+
+template <class Alloc>
+auto Vector<bool, Alloc>::bytes() noexcept -> std::span<std::byte> {
+    return {reinterpret_cast<std::byte*>(ptr), bytes_for(sz)};
+}
+
+template <class Alloc>
+auto Vector<bool, Alloc>::to_bytes(std::span<std::byte> out) const -> size_t {
+    size_t cnt = bytes_for(sz);
+    if (out.size() < cnt)
+        throw std::length_error(SHORT_SPAN_MSG);
+    if constexpr (std::endian::native == std::endian::little) {
+        if (cnt != 0)
+            std::memcpy(out.data(), ptr, cnt);
+    } else {
+        for (size_t i = 0; i < cnt; ++i)
+            out[i] = static_cast<std::byte>(ptr[i / sizeof(uint64_t)] >> (i % sizeof(uint64_t) * BITS_IN_BYTE));
+    }
+    return cnt;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::operator[](size_t idx) const noexcept -> bool {
+    return (ptr[idx / BITS_IN_WORD] >> (idx % BITS_IN_WORD)) & 1;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::operator[](size_t idx) noexcept -> BitReference {
+    return BitReference(ptr + idx / BITS_IN_WORD, idx % BITS_IN_WORD);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::front() const noexcept -> bool {
+    return (*this)[0];
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::front() noexcept -> BitReference {
+    return (*this)[0];
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::back() const noexcept -> bool {
+    return (*this)[sz - 1];
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::back() noexcept -> BitReference {
+    return (*this)[sz - 1];
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::reserve(size_t new_cap) -> void {
+    if (new_cap <= cap)
+        return;
+    size_t buf_cap = cap ? cap : INITIAL_CAP;
+    while (new_cap > buf_cap)
+        buf_cap *= GROWTH_RATE;
+    reallocate(buf_cap);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::shrink_to_fit() -> void {
+    if (words_for(sz) == words_for(cap))
+        return;
+    reallocate(words_for(sz) * BITS_IN_WORD);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::resize(size_t new_sz, bool val) -> void {
+    reserve(new_sz);
+    if (new_sz > sz) {
+        size_t head = std::min(new_sz, words_for(sz) * BITS_IN_WORD);
+        for (size_t i = sz; i < head; ++i)
+            (*this)[i] = val;
+        std::fill(ptr + words_for(sz), ptr + words_for(new_sz), val ? ~uint64_t(0) : 0);
+    }
+    sz = new_sz;
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::push_back(bool val) -> void {
+    reserve(sz + 1);
+    if (sz % BITS_IN_WORD == 0)
+        ptr[sz / BITS_IN_WORD] = val;
+    else
+        ptr[sz / BITS_IN_WORD] |= static_cast<uint64_t>(val) << (sz % BITS_IN_WORD);
+    ++sz;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::pop_back() noexcept -> void {
+    --sz;
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::clear() noexcept -> void {
+    sz = 0;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::flip() noexcept -> void {
+    for (size_t i = 0; i < words_for(sz); ++i)
+        ptr[i] = ~ptr[i];
+    clear_tail();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::count() const noexcept -> size_t {
+    size_t res = 0;
+    for (size_t i = 0; i < words_for(sz); ++i)
+        res += std::popcount(ptr[i]);
+    return res;
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::word(size_t idx) const noexcept -> uint64_t {
+    return ptr[idx];
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::begin() const noexcept -> BitReference {
+    return BitReference(ptr, 0);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::end() const noexcept -> BitReference {
+    return BitReference(ptr + sz / BITS_IN_WORD, sz % BITS_IN_WORD);
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::cbegin() const noexcept -> BitReference {
+    return begin();
+}
+
+template <class Alloc>
+constexpr auto Vector<bool, Alloc>::cend() const noexcept -> BitReference {
+    return end();
+}
+
+template <class Alloc>
+constexpr auto operator==(const Vector<bool, Alloc>& lhs, const Vector<bool, Alloc>& rhs) noexcept -> bool {
+    return lhs.size() == rhs.size() && std::ranges::equal(lhs.words(), rhs.words());
+}
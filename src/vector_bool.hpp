@@ -3,13 +3,21 @@
 #define VECTOR_BOOL_H
 
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <span>
 
-template <class T, class Alloc>
+template <class T, class Alloc = std::allocator<T>, class Size = size_t>
 class Vector;
 
+struct adopt_words_t {
+    explicit adopt_words_t() = default;
+};
+
+inline constexpr adopt_words_t adopt_words{};
+
 template <class Alloc>
 class Vector<bool, Alloc> {
 private:
@@ -29,13 +37,13 @@ public:
     using const_reverse_iterator = const reverse_iterator;
     constexpr Vector() noexcept(noexcept(Alloc()));
     explicit constexpr Vector(const Alloc& alloc) noexcept;
-    constexpr Vector(size_t sz, const T& val, const Alloc& alloc);
-    constexpr Vector(size_t sz, const T& val);
-    constexpr Vector(size_t sz);
+    constexpr Vector(size_t sz, const bool& val, const Alloc& alloc);
+    constexpr Vector(size_t sz, const bool& val);
+    explicit constexpr Vector(size_t sz);
     constexpr Vector(size_t sz, const Alloc& alloc);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr Vector(InputIt first, InputIt last, const Alloc& alloc);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr Vector(InputIt first, InputIt last);
     constexpr Vector(const Vector& other);
     constexpr Vector(const Vector& other, const Alloc& alloc);
@@ -43,15 +51,75 @@ public:
     constexpr Vector(Vector&& other, const Alloc& alloc);
     constexpr Vector(std::initializer_list<bool> init, const Alloc& alloc);
     constexpr Vector(std::initializer_list<bool> init);
+    constexpr Vector(std::span<const uint64_t> words, size_t bits, const Alloc& alloc);
+    constexpr Vector(std::span<const uint64_t> words, size_t bits);
+    constexpr Vector(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits, const Alloc& alloc);
+    constexpr Vector(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits);
+    static Vector from_bytes(std::span<const std::byte> bytes, size_t bits, const Alloc& alloc = Alloc());
+    constexpr ~Vector();
+    constexpr Vector& operator=(const Vector& other) &;
+    constexpr Vector& operator=(Vector&& other) & noexcept;
+    constexpr void swap(Vector& other) & noexcept;
+    constexpr size_t size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr size_t capacity() const noexcept;
+    constexpr Alloc get_allocator() const noexcept;
+    constexpr void assign(std::span<const uint64_t> words, size_t bits);
+    constexpr void assign(adopt_words_t, uint64_t* words, size_t word_cap, size_t bits);
+    constexpr std::span<const uint64_t> words() const noexcept;
+    constexpr std::span<uint64_t> words() noexcept;
+    std::span<const std::byte> bytes() const noexcept;
+    std::span<std::byte> bytes() noexcept;
+    size_t to_bytes(std::span<std::byte> out) const;
+    constexpr bool operator[](size_t idx) const noexcept;
+    constexpr BitReference operator[](size_t idx) noexcept;
+    constexpr bool front() const noexcept;
+    constexpr BitReference front() noexcept;
+    constexpr bool back() const noexcept;
+    constexpr BitReference back() noexcept;
+    constexpr void reserve(size_t new_cap);
+    constexpr void shrink_to_fit();
+    constexpr void resize(size_t new_sz, bool val = false);
+    constexpr void push_back(bool val);
+    constexpr void pop_back() noexcept;
+    constexpr void clear() noexcept;
+    constexpr void flip() noexcept;
+    constexpr size_t count() const noexcept;
+    constexpr uint64_t word(size_t idx) const noexcept;
+    constexpr BitReference begin() const noexcept;
+    constexpr BitReference end() const noexcept;
+    constexpr BitReference cbegin() const noexcept;
+    constexpr BitReference cend() const noexcept;
 private:
-    using AllocTraits = std::allocator_traits<Alloc>::rebind_traits<uint8_t>;
-    static const size_t INITIAL_CAP = 4;
+    using AllocTraits = typename std::allocator_traits<Alloc>::template rebind_traits<uint64_t>;
+    using WordAlloc = typename AllocTraits::allocator_type;
+    static const size_t INITIAL_CAP = 64;
     static const size_t GROWTH_RATE = 2;
     static const size_t BITS_IN_BYTE = 8;
-    Alloc alloc;
+    static const size_t BITS_IN_WORD = 64;
+    static constexpr const char* SHORT_SPAN_MSG = "Vector<bool>: span is too short for the requested bits";
+    static constexpr const char* SHORT_BUFFER_MSG = "Vector<bool>: adopted buffer is too short for the requested bits";
+    static constexpr const char* SELF_ADOPT_MSG = "Vector<bool>: cannot adopt its own buffer";
+    static constexpr size_t bytes_for(size_t bits) noexcept;
+    static constexpr size_t adopted_capacity(size_t word_cap, size_t bits);
+    static constexpr size_t words_for(size_t bits) noexcept;
+    constexpr void reallocate(size_t new_cap);
+    constexpr void clear_tail() noexcept;
+    WordAlloc alloc;
     size_t sz = 0;
-    size_t cap = INITIAL_CAP;
-    uint8_t* ptr = nullptr;
+    size_t cap = 0;
+    uint64_t* ptr = nullptr;
 };
 
+template <class Alloc>
+constexpr bool operator==(const Vector<bool, Alloc>& lhs, const Vector<bool, Alloc>& rhs) noexcept;
+
+#include "bit_reference.hpp"
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "vector_bool.cpp"
+#endif
+#undef HEADER_INCLUDES
+
 #endif
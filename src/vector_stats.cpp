@@ -0,0 +1,219 @@
+#ifndef HEADER_INCLUDES
+#define IMPL_INCLUDES
+#include "vector_stats.hpp"
+#undef IMPL_INCLUDES
+#endif
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+namespace detail::stats {
+struct Registry {
+    std::mutex lock;
+    vector_stats::Entry* head = nullptr;
+};
+
+struct ThreadEntries {
+    vector_stats::Entry* head = nullptr;
+    bool exited = false;
+    ~ThreadEntries();
+};
+
+inline thread_local ThreadEntries local;
+
+inline auto registry() noexcept -> Registry& {
+    static Registry res;
+    return res;
+}
+
+inline auto add(vector_stats::Counters& to, const vector_stats::Counters& from) noexcept -> void {
+    to.allocations += from.allocations;
+    to.bytes_allocated += from.bytes_allocated;
+    to.reallocations += from.reallocations;
+    to.copied += from.copied;
+    to.moved += from.moved;
+    to.relocated += from.relocated;
+    to.peak_capacity = std::max(to.peak_capacity, from.peak_capacity);
+    to.wasted_bytes += from.wasted_bytes;
+    to.released += from.released;
+}
+
+inline ThreadEntries::~ThreadEntries() {
+    exited = true;
+    Registry& reg = registry();
+    std::lock_guard guard(reg.lock);
+    for (vector_stats::Entry* entry = head; entry != nullptr; entry = entry->next) {
+        vector_stats::Entry* total = reg.head;
+        while (total != nullptr && total->type != entry->type)
+            total = total->next;
+        if (total == nullptr) {
+            total = new (std::nothrow) vector_stats::Entry{entry->type, entry->elem_size, {}, reg.head};
+            if (total == nullptr)
+                continue;
+            reg.head = total;
+        }
+        add(total->counters, entry->counters);
+    }
+    head = nullptr;
+}
+
+inline auto snapshot() -> std::vector<vector_stats::Entry> {
+    std::vector<vector_stats::Entry> res;
+    auto merge = [&] (const vector_stats::Entry* entry) {
+        for (; entry != nullptr; entry = entry->next) {
+            auto it = std::find_if(res.begin(), res.end(), [&] (const vector_stats::Entry& total) {
+                return total.type == entry->type;
+            });
+            if (it == res.end())
+                it = res.insert(res.end(), vector_stats::Entry{entry->type, entry->elem_size, {}, nullptr});
+            add(it->counters, entry->counters);
+        }
+    };
+    Registry& reg = registry();
+    std::lock_guard guard(reg.lock);
+    merge(reg.head);
+    merge(local.head);
+    return res;
+}
+
+inline auto demangle(const char* name) -> std::string {
+#if __has_include(<cxxabi.h>)
+    int status = 0;
+    std::unique_ptr<char, decltype(&std::free)> res(abi::__cxa_demangle(name, nullptr, nullptr, &status), &std::free);
+    if (status == 0)
+        return res.get();
+#endif
+    return name;
+}
+
+template <class T>
+auto type_name() -> const char* {
+    static const std::string name = demangle(typeid(T).name());
+    return name.c_str();
+}
+
+template <class T>
+auto entry_for() -> vector_stats::Entry& {
+    thread_local vector_stats::Entry entry{type_name<T>(), sizeof(T), {}, nullptr};
+    thread_local bool registered = false;
+    if (!registered && !local.exited) {
+        entry.next = local.head;
+        local.head = &entry;
+        registered = true;
+    }
+    return entry;
+}
+
+template <class T, class F>
+constexpr auto update(F&& func) noexcept -> void {
+    if constexpr (vector_stats::ENABLED) {
+        if (std::is_constant_evaluated())
+            return;
+        func(vector_stats::counters_for<T>());
+    }
+}
+
+template <class T>
+constexpr auto allocated(size_t cap, bool reallocation) noexcept -> void {
+    update<T>([&] (vector_stats::Counters& counters) {
+        ++counters.allocations;
+        counters.bytes_allocated += cap * sizeof(T);
+        counters.reallocations += reallocation;
+        counters.peak_capacity = std::max(counters.peak_capacity, cap);
+    });
+}
+
+template <class T>
+constexpr auto copied(size_t cnt) noexcept -> void {
+    update<T>([&] (vector_stats::Counters& counters) {
+        counters.copied += cnt;
+    });
+}
+
+template <class T>
+constexpr auto moved(size_t cnt) noexcept -> void {
+    update<T>([&] (vector_stats::Counters& counters) {
+        counters.moved += cnt;
+    });
+}
+
+template <class T>
+constexpr auto relocated(size_t cnt) noexcept -> void {
+    update<T>([&] (vector_stats::Counters& counters) {
+        counters.relocated += cnt;
+    });
+}
+
+template <class T>
+constexpr auto released(size_t sz, size_t cap) noexcept -> void {
+    update<T>([&] (vector_stats::Counters& counters) {
+        ++counters.released;
+        counters.wasted_bytes += (cap - sz) * sizeof(T);
+    });
+}
+}
+
+template <class T>
+auto vector_stats::counters_for() -> Counters& {
+    return detail::stats::entry_for<T>().counters;
+}
+
+template <class T>
+auto vector_stats::totals() -> Counters {
+    const char* type = detail::stats::type_name<T>();
+    for (const Entry& entry : detail::stats::snapshot())
+        if (entry.type == type)
+            return entry.counters;
+    return Counters();
+}
+
+inline auto vector_stats::entries() noexcept -> const Entry* {
+    return detail::stats::local.head;
+}
+
+inline auto vector_stats::reset() noexcept -> void {
+    detail::stats::Registry& reg = detail::stats::registry();
+    std::lock_guard guard(reg.lock);
+    for (Entry* entry = reg.head; entry != nullptr; entry = entry->next)
+        entry->counters = Counters();
+    for (Entry* entry = detail::stats::local.head; entry != nullptr; entry = entry->next)
+        entry->counters = Counters();
+}
+
+inline auto vector_stats::dump_text(FILE* out) -> void {
+    fprintf(out, "%-32s %8s %12s %8s %10s %10s %10s %10s %12s\n",
+        "type", "allocs", "bytes", "reallocs", "copied", "moved", "relocated", "peak cap", "wasted");
+    for (const Entry& entry : detail::stats::snapshot()) {
+        const Counters& cnt = entry.counters;
+        fprintf(out, "%-32s %8zu %12zu %8zu %10zu %10zu %10zu %10zu %12zu\n",
+            entry.type, cnt.allocations, cnt.bytes_allocated, cnt.reallocations,
+            cnt.copied, cnt.moved, cnt.relocated, cnt.peak_capacity, cnt.wasted_bytes);
+    }
+}
+
+inline auto vector_stats::dump_json(FILE* out) -> void {
+    std::vector<Entry> all = detail::stats::snapshot();
+    fprintf(out, "[");
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Counters& cnt = all[i].counters;
+        fprintf(out,
+            "%s\n  {\"type\": \"%s\", \"elem_size\": %zu, \"allocations\": %zu, \"bytes_allocated\": %zu, "
+            "\"reallocations\": %zu, \"copied\": %zu, \"moved\": %zu, \"relocated\": %zu, "
+            "\"peak_capacity\": %zu, \"wasted_bytes\": %zu, \"released\": %zu}",
+            i == 0 ? "" : ",", all[i].type, all[i].elem_size,
+            cnt.allocations, cnt.bytes_allocated, cnt.reallocations, cnt.copied, cnt.moved,
+            cnt.relocated, cnt.peak_capacity, cnt.wasted_bytes, cnt.released);
+    }
+    fprintf(out, "%s]\n", all.empty() ? "" : "\n");
+}
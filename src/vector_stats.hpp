@@ -0,0 +1,63 @@
+#ifndef VECTOR_STATS_H
+
+#define VECTOR_STATS_H
+
+#include <cstddef>
+#include <cstdio>
+
+namespace vector_stats {
+struct Counters {
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    size_t reallocations = 0;
+    size_t copied = 0;
+    size_t moved = 0;
+    size_t relocated = 0;
+    size_t peak_capacity = 0;
+    size_t wasted_bytes = 0;
+    size_t released = 0;
+};
+
+struct Entry {
+    const char* type;
+    size_t elem_size;
+    Counters counters;
+    Entry* next;
+};
+
+#ifdef VECTOR_ENABLE_STATS
+const bool ENABLED = true;
+#else
+const bool ENABLED = false;
+#endif
+
+template <class T>
+Counters& counters_for();
+template <class T>
+Counters totals();
+const Entry* entries() noexcept;
+void reset() noexcept;
+void dump_text(FILE* out = stdout);
+void dump_json(FILE* out = stdout);
+}
+
+namespace detail::stats {
+template <class T>
+constexpr void allocated(size_t cap, bool reallocation) noexcept;
+template <class T>
+constexpr void copied(size_t cnt) noexcept;
+template <class T>
+constexpr void moved(size_t cnt) noexcept;
+template <class T>
+constexpr void relocated(size_t cnt) noexcept;
+template <class T>
+constexpr void released(size_t sz, size_t cap) noexcept;
+}
+
+#define HEADER_INCLUDES
+#ifndef IMPL_INCLUDES
+#include "vector_stats.cpp"
+#endif
+#undef HEADER_INCLUDES
+
+#endif